@@ -0,0 +1,472 @@
+#include "Common.hpp"
+#include <openvox.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+
+using namespace vmath;
+
+// Voxelizes the demo's tube meshes through every backend at a sweep of resolutions, and
+// writes the timings as JSON to stdout or to the --output file.  Progress goes to stderr.
+//
+//   Benchmark [--lod 96] [--frames 10] [--warmup 2] [--animate] [--threads 0]
+//             [--resolutions 128x64x16,256x128x32,...] [--backends cpu-thin,opencl,...]
+//             [--kernels ../SurfaceVoxels/] [--output results.json]
+//
+// Triangle rates count the triangles each frame hands to the backend: all of them, except
+// for cpu-incremental, which only gets the ones that moved.  It is skipped without
+// --animate, where nothing moves and there is nothing to time.
+//
+// With --verify, runs that many random cases through the surface voxelizers instead, checks
+// them against the reference voxelizer, and exits non-zero if any backend fails.  Failing
+// cases are reproduced by passing the reported seed with --verify 1.
+//
+//   Benchmark --verify 1000 [--seed 1] [--tolerance 0.001] [--resolutions 32x32x32]
+//
+// With --verify-transforms, does the same for voxTransform: distances, gradients, curls,
+// advection and narrow bands, each against brute force on small random volumes.
+//
+//   Benchmark --verify-transforms 100 [--seed 1]
+
+// Verify.cpp
+int VerifyVoxelizers(int cases, unsigned int seed, float tolerance, int width, int height, int depth,
+                     bool useOpenCL, const char* kernelFolder, void (*handleError)(const char*, void*), FILE* file);
+
+// VerifyTransforms.cpp
+int VerifyTransforms(int cases, unsigned int seed, void (*handleError)(const char*, void*), FILE* file);
+
+struct ResolutionPod {
+    int Width;
+    int Height;
+    int Depth;
+};
+
+struct BackendPod {
+    const char* Name;
+    VOXenum Op;
+    VOXenum Storage;
+    bool Incremental;
+};
+
+struct ResultPod {
+    const char* Backend;
+    ResolutionPod Resolution;
+    double MeanMilliseconds;
+    double MinMilliseconds;
+    double MaxMilliseconds;
+    double DeviceMilliseconds; // OpenCL only, from the queue's profiling events
+    double TrianglesPerFrame;
+    VOXuint64 VoxelCount;      // set in the volume after the last frame
+};
+
+struct WorkloadPod {
+    TubePod Primary;
+    TubePod Stent;
+    TubePod Helix;
+    Point3 MinCorner;
+    Point3 MaxCorner;
+    size_t TriangleCount;
+    TubePod* Tubes[3];
+};
+
+static const BackendPod CpuBackends[] = {
+    { "cpu-volumetric",   VOX_VOXELIZE_VOLUMETRIC,           VOX_STORAGE_DENSE,  false },
+    { "cpu-conservative", VOX_VOXELIZE_SURFACE_CONSERVATIVE, VOX_STORAGE_DENSE,  false },
+    { "cpu-incremental",  VOX_VOXELIZE_SURFACE_CONSERVATIVE, VOX_STORAGE_DENSE,  true  },
+    { "cpu-sparse",       VOX_VOXELIZE_SURFACE_CONSERVATIVE, VOX_STORAGE_SPARSE, false },
+    { "cpu-thin",         VOX_VOXELIZE_SURFACE_THIN,         VOX_STORAGE_DENSE,  false },
+    { "cpu-hash",         VOX_VOXELIZE_SPATIAL_HASH,         VOX_STORAGE_HASH,   false },
+    { "cpu-octree",       VOX_VOXELIZE_SURFACE_OCTREE,       VOX_STORAGE_OCTREE, false },
+};
+
+static const float FrameTime = 1.0f / 60.0f;
+
+// Settings:
+static int Lod = 96;
+static int Frames = 10;
+static int Warmup = 2;
+static bool Animate = false;
+static unsigned int ThreadCount = 0;
+static const char* KernelFolder = "../SurfaceVoxels/";
+static const char* OutputFile = 0;
+static std::vector<ResolutionPod> Resolutions;
+static std::vector<std::string> Selected;
+static int VerifyCases = 0;
+static int VerifyTransformCases = 0;
+static unsigned int Seed = 1;
+static float Tolerance = 1e-3f; // voxels
+
+// Voxelize.cpp reports through these on the headless path.
+void PezDebugString(const char* pStr, ...)
+{
+    va_list a;
+    va_start(a, pStr);
+    vfprintf(stderr, pStr, a);
+    va_end(a);
+}
+
+void PezFatalError(const char* pStr, ...)
+{
+    va_list a;
+    va_start(a, pStr);
+    vfprintf(stderr, pStr, a);
+    va_end(a);
+    exit(1);
+}
+
+void PezCheckCondition(int condition, ...)
+{
+    va_list a;
+    const char* pStr;
+
+    if (condition)
+        return;
+
+    va_start(a, condition);
+    pStr = va_arg(a, const char*);
+    vfprintf(stderr, pStr, a);
+    va_end(a);
+    exit(1);
+}
+
+static void HandleError(const char* message, void*)
+{
+    PezFatalError("OpenVOX: %s", message);
+}
+
+static bool IsSelected(const char* backend)
+{
+    return Selected.empty() || std::find(Selected.begin(), Selected.end(), backend) != Selected.end();
+}
+
+static double Seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// The same three tubes as the demo, scaled by one level of detail.  Each run gets fresh ones,
+// so that every backend sees the same animation.
+static void CreateWorkload(WorkloadPod& workload)
+{
+    PezCheckCondition(Lod >= 18, "The level of detail must be at least 18.\n");
+    workload.Primary = CreatePrimary(Lod);
+    workload.Stent = CreateStent(std::max(Lod / 4, 18));
+    workload.Helix = CreateHelix(std::max(Lod * 2 / 3, 18), workload.Primary);
+    workload.Tubes[0] = &workload.Primary;
+    workload.Tubes[1] = &workload.Stent;
+    workload.Tubes[2] = &workload.Helix;
+
+    workload.MinCorner = workload.Primary.Mesh.MinCorner;
+    workload.MaxCorner = workload.Primary.Mesh.MaxCorner;
+    workload.TriangleCount = 0;
+    for (int t = 0; t < 3; ++t) {
+        workload.MinCorner = minPerElem(workload.MinCorner, workload.Tubes[t]->Mesh.MinCorner);
+        workload.MaxCorner = maxPerElem(workload.MaxCorner, workload.Tubes[t]->Mesh.MaxCorner);
+        workload.TriangleCount += workload.Tubes[t]->Mesh.TriangleCount;
+    }
+}
+
+// Triangles with a vertex that differs from before.
+static size_t CountMovedTriangles(const TubePod& tube, const TubeBuffer& before)
+{
+    size_t count = 0;
+    for (size_t f = 0; f + 2 < tube.Faces.size(); f += 3)
+        for (int i = 0; i < 3; ++i) {
+            const TubeVertex& a = tube.Verts[tube.Faces[f + i]];
+            const TubeVertex& b = before[tube.Faces[f + i]];
+            if (a.Px != b.Px || a.Py != b.Py || a.Pz != b.Pz) {
+                ++count;
+                break;
+            }
+        }
+    return count;
+}
+
+static void Summarize(ResultPod& result, const std::vector<double>& seconds)
+{
+    double total = 0;
+    for (size_t i = 0; i < seconds.size(); ++i)
+        total += seconds[i];
+    result.MeanMilliseconds = 1000.0 * total / seconds.size();
+    result.MinMilliseconds = 1000.0 * *std::min_element(seconds.begin(), seconds.end());
+    result.MaxMilliseconds = 1000.0 * *std::max_element(seconds.begin(), seconds.end());
+}
+
+// One frame clears the volume, unless it is incremental, and voxelizes the three tubes into
+// it; with --animate the tubes move first, outside the timed part, and are uploaded inside it.
+static ResultPod RunCpu(VOXhandle context, WorkloadPod& workload, const BackendPod& backend, ResolutionPod resolution)
+{
+    float bounds[6];
+    for (int c = 0; c < 3; ++c) {
+        bounds[c] = workload.MinCorner[c];
+        bounds[c + 3] = workload.MaxCorner[c];
+    }
+    voxSetParamfv(VOX_PARAM_VOXELIZE_BOUNDS, bounds);
+    voxSetParam1ui(VOX_PARAM_VOLUME_STORAGE, backend.Storage);
+    voxSetParam1b(VOX_PARAM_INCREMENTAL, backend.Incremental);
+
+    VOXhandle meshes[3];
+    for (int t = 0; t < 3; ++t) {
+        const TubePod& tube = *workload.Tubes[t];
+        meshes[t] = voxRegisterMeshPtr(context, &tube.Verts[0], &tube.Faces[0], sizeof(TubeVertex),
+            VOX_TYPE_UINT32, tube.Mesh.VertexCount, tube.Mesh.TriangleCount);
+    }
+    VOXhandle volume = voxCreateVolume(context, resolution.Width, resolution.Height, resolution.Depth,
+        VOX_TYPE_UINT8, VOX_SOURCE_IGNORE_PTR, 0);
+    voxGenerate(volume, VOX_GENERATE_CLEAR);
+
+    std::vector<double> seconds;
+    size_t triangles = 0;
+    TubeBuffer before[3];
+    for (int frame = 0; frame < Warmup + Frames; ++frame) {
+        if (Animate) {
+            for (int t = 0; t < 3; ++t)
+                before[t] = workload.Tubes[t]->Verts;
+            AnimateTubes(workload.Primary, workload.Helix, FrameTime);
+        }
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (!backend.Incremental)
+            voxGenerate(volume, VOX_GENERATE_CLEAR);
+        for (int t = 0; t < 3 && Animate; ++t)
+            voxUpdateMesh(meshes[t], VOX_SOURCE_CPU_MEMORY, &workload.Tubes[t]->Verts[0]);
+        for (int t = 0; t < 3; ++t)
+            voxVoxelize(meshes[t], volume, backend.Op);
+        if (frame < Warmup)
+            continue;
+        seconds.push_back(Seconds(start));
+        for (int t = 0; t < 3; ++t)
+            triangles += backend.Incremental ? CountMovedTriangles(*workload.Tubes[t], before[t]) : workload.Tubes[t]->Mesh.TriangleCount;
+    }
+
+    ResultPod result;
+    result.Backend = backend.Name;
+    result.Resolution = resolution;
+    result.DeviceMilliseconds = -1;
+    result.TrianglesPerFrame = (double) triangles / Frames;
+    result.VoxelCount = voxCountVoxels(volume);
+    Summarize(result, seconds);
+
+    voxDeleteHandle(volume);
+    for (int t = 0; t < 3; ++t)
+        voxDeleteHandle(meshes[t]);
+    voxResetParamv(VOX_PARAM_VOXELIZE_BOUNDS);
+    voxResetParamv(VOX_PARAM_VOLUME_STORAGE);
+    voxResetParamv(VOX_PARAM_INCREMENTAL);
+    return result;
+}
+
+#ifdef BENCHMARK_OPENCL
+// With distances, opencl-jfa, every frame also jump floods the volume it voxelized.
+static ResultPod RunOpenCL(WorkloadPod& workload, ResolutionPod resolution, bool distances)
+{
+    InitHeadlessOpenCL(resolution.Width, resolution.Height, resolution.Depth, KernelFolder);
+    EnableOpenCLDistances(distances);
+    int meshes[3];
+    for (int t = 0; t < 3; ++t) {
+        const TubePod& tube = *workload.Tubes[t];
+        meshes[t] = AddHeadlessMesh(&tube.Verts[0].Px, tube.Mesh.VertexCount, &tube.Faces[0], tube.Mesh.TriangleCount);
+    }
+
+    std::vector<double> seconds;
+    double deviceMicroseconds = 0;
+    for (int frame = 0; frame < Warmup + Frames; ++frame) {
+        if (Animate)
+            AnimateTubes(workload.Primary, workload.Helix, FrameTime);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int t = 0; Animate && t < 3; ++t)
+            UpdateHeadlessMesh(meshes[t], &workload.Tubes[t]->Verts[0].Px);
+        double microseconds = RunHeadlessOpenCL(workload.MinCorner, workload.MaxCorner, 0);
+        if (frame >= Warmup) {
+            seconds.push_back(Seconds(start));
+            deviceMicroseconds += microseconds;
+        }
+    }
+
+    // One more pass, untimed, to count what the frames wrote.
+    std::vector<unsigned char> voxels((size_t) resolution.Width * resolution.Height * resolution.Depth);
+    RunHeadlessOpenCL(workload.MinCorner, workload.MaxCorner, &voxels[0]);
+
+    ResultPod result;
+    result.Backend = distances ? "opencl-jfa" : "opencl";
+    result.Resolution = resolution;
+    result.DeviceMilliseconds = deviceMicroseconds / 1000.0 / Frames;
+    result.TrianglesPerFrame = (double) workload.TriangleCount;
+    result.VoxelCount = voxels.size() - std::count(voxels.begin(), voxels.end(), 0);
+    Summarize(result, seconds);
+
+    EnableOpenCLDistances(false);
+    ClearOpenCL();
+    return result;
+}
+#endif
+
+static void WriteJson(FILE* file, const WorkloadPod& workload, const std::vector<ResultPod>& results)
+{
+    const char* names[] = { "primary", "stent", "helix" };
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"lod\": %d,\n  \"frames\": %d,\n  \"warmup\": %d,\n  \"animate\": %s,\n  \"threads\": %u,\n",
+        Lod, Frames, Warmup, Animate ? "true" : "false", ThreadCount);
+    fprintf(file, "  \"meshes\": [\n");
+    for (int t = 0; t < 3; ++t)
+        fprintf(file, "    { \"name\": \"%s\", \"vertices\": %d, \"triangles\": %d }%s\n", names[t],
+            (int) workload.Tubes[t]->Mesh.VertexCount, (int) workload.Tubes[t]->Mesh.TriangleCount, t < 2 ? "," : "");
+    fprintf(file, "  ],\n");
+    fprintf(file, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const ResultPod& r = results[i];
+        double seconds = r.MeanMilliseconds / 1000.0;
+        fprintf(file, "    { \"backend\": \"%s\", \"width\": %d, \"height\": %d, \"depth\": %d, ",
+            r.Backend, r.Resolution.Width, r.Resolution.Height, r.Resolution.Depth);
+        fprintf(file, "\"triangles_per_frame\": %.1f, \"voxels_set\": %llu,\n", r.TrianglesPerFrame, r.VoxelCount);
+        fprintf(file, "      \"ms_per_frame\": %.4f, \"ms_min\": %.4f, \"ms_max\": %.4f, ",
+            r.MeanMilliseconds, r.MinMilliseconds, r.MaxMilliseconds);
+        if (r.DeviceMilliseconds >= 0)
+            fprintf(file, "\"device_ms_per_frame\": %.4f, ", r.DeviceMilliseconds);
+        fprintf(file, "\"triangles_per_second\": %.1f }%s\n", r.TrianglesPerFrame / seconds, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+}
+
+static void Split(const char* list, std::vector<std::string>& items)
+{
+    std::string all(list);
+    size_t start = 0;
+    while (start <= all.size()) {
+        size_t end = all.find(',', start);
+        if (end == std::string::npos)
+            end = all.size();
+        if (end > start)
+            items.push_back(all.substr(start, end - start));
+        start = end + 1;
+    }
+}
+
+static void ParseArguments(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : 0;
+        if (!strcmp(arg, "--animate")) {
+            Animate = true;
+            continue;
+        }
+        PezCheckCondition(value != 0, "Missing value for %s.\n", arg);
+        ++i;
+        if (!strcmp(arg, "--lod")) Lod = atoi(value);
+        else if (!strcmp(arg, "--frames")) Frames = atoi(value);
+        else if (!strcmp(arg, "--warmup")) Warmup = atoi(value);
+        else if (!strcmp(arg, "--threads")) ThreadCount = (unsigned int) atoi(value);
+        else if (!strcmp(arg, "--kernels")) KernelFolder = value;
+        else if (!strcmp(arg, "--output")) OutputFile = value;
+        else if (!strcmp(arg, "--backends")) Split(value, Selected);
+        else if (!strcmp(arg, "--verify")) VerifyCases = atoi(value);
+        else if (!strcmp(arg, "--verify-transforms")) VerifyTransformCases = atoi(value);
+        else if (!strcmp(arg, "--seed")) Seed = (unsigned int) strtoul(value, 0, 10);
+        else if (!strcmp(arg, "--tolerance")) Tolerance = (float) atof(value);
+        else if (!strcmp(arg, "--resolutions")) {
+            std::vector<std::string> items;
+            Split(value, items);
+            for (size_t r = 0; r < items.size(); ++r) {
+                ResolutionPod resolution;
+                int fields = sscanf(items[r].c_str(), "%dx%dx%d", &resolution.Width, &resolution.Height, &resolution.Depth);
+                PezCheckCondition(fields == 3 && resolution.Width > 0 && resolution.Height > 0 && resolution.Depth > 0,
+                    "Bad resolution '%s'; expected WxHxD.\n", items[r].c_str());
+                Resolutions.push_back(resolution);
+            }
+        }
+        else PezFatalError("Unknown option %s.\n", arg);
+    }
+    PezCheckCondition(Frames > 0 && Warmup >= 0, "Need at least one frame.\n");
+
+    // Small grids keep the reference fast and make every triangle cross many voxel faces.
+    if (Resolutions.empty() && VerifyCases > 0) {
+        ResolutionPod verify = { 32, 32, 32 };
+        Resolutions.push_back(verify);
+    }
+
+    // The demo's volume is 512x256x64; sweep from a quarter to twice that.
+    if (Resolutions.empty()) {
+        ResolutionPod sweep[] = { { 128, 64, 16 }, { 256, 128, 32 }, { 512, 256, 64 }, { 1024, 512, 128 } };
+        Resolutions.assign(sweep, sweep + 4);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    ParseArguments(argc, argv);
+
+    voxSetParam1ui(VOX_PARAM_THREAD_COUNT, ThreadCount);
+
+    if (VerifyCases > 0) {
+        bool useOpenCL = false;
+#ifdef BENCHMARK_OPENCL
+        useOpenCL = IsSelected("opencl");
+#endif
+        FILE* file = OutputFile ? fopen(OutputFile, "w") : stdout;
+        PezCheckCondition(file != 0, "Unable to write %s.\n", OutputFile);
+        ResolutionPod resolution = Resolutions[0];
+        int failing = VerifyVoxelizers(VerifyCases, Seed, Tolerance, resolution.Width, resolution.Height, resolution.Depth,
+            useOpenCL, KernelFolder, HandleError, file);
+        if (file != stdout)
+            fclose(file);
+        return failing ? 1 : 0;
+    }
+
+    if (VerifyTransformCases > 0) {
+        FILE* file = OutputFile ? fopen(OutputFile, "w") : stdout;
+        PezCheckCondition(file != 0, "Unable to write %s.\n", OutputFile);
+        int failing = VerifyTransforms(VerifyTransformCases, Seed, HandleError, file);
+        if (file != stdout)
+            fclose(file);
+        return failing ? 1 : 0;
+    }
+
+    VOXhandle context = voxCreateContext(HandleError, 0);
+
+    std::vector<ResultPod> results;
+    for (size_t r = 0; r < Resolutions.size(); ++r) {
+        ResolutionPod resolution = Resolutions[r];
+        for (size_t b = 0; b < sizeof(CpuBackends) / sizeof(CpuBackends[0]); ++b) {
+            if (!IsSelected(CpuBackends[b].Name))
+                continue;
+            if (CpuBackends[b].Incremental && !Animate) {
+                fprintf(stderr, "%s needs --animate; skipped\n", CpuBackends[b].Name);
+                continue;
+            }
+            fprintf(stderr, "%s %dx%dx%d\n", CpuBackends[b].Name, resolution.Width, resolution.Height, resolution.Depth);
+            WorkloadPod workload;
+            CreateWorkload(workload);
+            results.push_back(RunCpu(context, workload, CpuBackends[b], resolution));
+        }
+#ifdef BENCHMARK_OPENCL
+        if (IsSelected("opencl")) {
+            fprintf(stderr, "opencl %dx%dx%d\n", resolution.Width, resolution.Height, resolution.Depth);
+            WorkloadPod workload;
+            CreateWorkload(workload);
+            results.push_back(RunOpenCL(workload, resolution, false));
+        }
+        if (IsSelected("opencl-jfa")) {
+            fprintf(stderr, "opencl-jfa %dx%dx%d\n", resolution.Width, resolution.Height, resolution.Depth);
+            WorkloadPod workload;
+            CreateWorkload(workload);
+            results.push_back(RunOpenCL(workload, resolution, true));
+        }
+#endif
+    }
+    voxDeleteHandle(context);
+
+    WorkloadPod workload;
+    CreateWorkload(workload);
+    FILE* file = OutputFile ? fopen(OutputFile, "w") : stdout;
+    PezCheckCondition(file != 0, "Unable to write %s.\n", OutputFile);
+    WriteJson(file, workload, results);
+    if (file != stdout)
+        fclose(file);
+    return 0;
+}
@@ -0,0 +1,348 @@
+#include "Common.hpp"
+#include <openvox.h>
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include <random>
+
+using namespace vmath;
+
+// Differential testing of the surface voxelizers against VOX_VOXELIZE_SURFACE_REFERENCE.
+// Every case is a handful of random triangles, mixed with degenerate ones, slivers, and ones
+// snapped to voxel centers and faces where ties are decided, voxelized with a random
+// non-uniform scale and offset.  The reference runs twice, with its boxes shrunk and grown
+// by the tolerance: voxels set even by the shrunk run must be set by every conservative
+// backend.  The thin backend rounds the plane's depth at column centers up to half a voxel
+// past the triangle's edges, so its voxels may land one step off the grown run, but no more.
+// Voxels in between the two runs are too close to call in single precision.  The incremental
+// backends start from the case with some of its triangles moved, then move them back with
+// voxUpdateMesh, so that what they are checked on is the second, partial pass; beyond the
+// reference, it must match a full rebuild exactly, or voxels left behind would go unnoticed.
+
+enum Expectation {
+    ExpectSuperset, // conservative: may add voxels, may not miss any
+    ExpectAdjacent, // thin: may leave voxels out, may add only next to the surface
+};
+
+struct VerifyBackendPod {
+    const char* Name;
+    VOXenum Op;
+    VOXenum Storage;
+    VOXenum Type;
+    VOXuint SimdWidth;
+    bool PlaneSpans;
+    bool Incremental;
+    Expectation Expect;
+};
+
+struct VerifyResultPod {
+    unsigned int Failures;
+    unsigned long long Missing;  // in the shrunk reference, but not in the backend
+    unsigned long long Extra;    // in the backend, but not in the grown reference
+    unsigned long long Stray;    // in the backend, and not even 6-adjacent to the grown reference
+    unsigned long long Rebuild;  // incremental only: different from a full rebuild
+    long long FirstFailure;      // seed of the first failing case, or -1
+};
+
+struct CasePod {
+    std::vector<float> Positions;
+    std::vector<VOXuint> Indices;
+    float Bounds[6];
+};
+
+static const VerifyBackendPod VerifyBackends[] = {
+    { "cpu-conservative-scalar", VOX_VOXELIZE_SURFACE_CONSERVATIVE, VOX_STORAGE_DENSE,  VOX_TYPE_UINT8, 1,  false, false, ExpectSuperset },
+    { "cpu-conservative-avx2",   VOX_VOXELIZE_SURFACE_CONSERVATIVE, VOX_STORAGE_DENSE,  VOX_TYPE_UINT8, 8,  false, false, ExpectSuperset },
+    { "cpu-conservative-avx512", VOX_VOXELIZE_SURFACE_CONSERVATIVE, VOX_STORAGE_DENSE,  VOX_TYPE_UINT8, 16, false, false, ExpectSuperset },
+    { "cpu-plane-spans",         VOX_VOXELIZE_SURFACE_CONSERVATIVE, VOX_STORAGE_DENSE,  VOX_TYPE_UINT8, 0,  true,  false, ExpectSuperset },
+    { "cpu-bit",                 VOX_VOXELIZE_SURFACE_CONSERVATIVE, VOX_STORAGE_DENSE,  VOX_TYPE_BIT,   0,  false, false, ExpectSuperset },
+    { "cpu-incremental",         VOX_VOXELIZE_SURFACE_CONSERVATIVE, VOX_STORAGE_DENSE,  VOX_TYPE_UINT8, 0,  false, true,  ExpectSuperset },
+    { "cpu-incremental-sparse",  VOX_VOXELIZE_SURFACE_CONSERVATIVE, VOX_STORAGE_SPARSE, VOX_TYPE_UINT8, 0,  false, true,  ExpectSuperset },
+    { "cpu-sparse",              VOX_VOXELIZE_SURFACE_CONSERVATIVE, VOX_STORAGE_SPARSE, VOX_TYPE_UINT8, 0,  false, false, ExpectSuperset },
+    { "cpu-hash",                VOX_VOXELIZE_SPATIAL_HASH,         VOX_STORAGE_HASH,   VOX_TYPE_UINT8, 0,  false, false, ExpectSuperset },
+    { "cpu-octree",              VOX_VOXELIZE_SURFACE_OCTREE,       VOX_STORAGE_OCTREE, VOX_TYPE_UINT8, 0,  false, false, ExpectSuperset },
+    { "cpu-thin",                VOX_VOXELIZE_SURFACE_THIN,         VOX_STORAGE_DENSE,  VOX_TYPE_UINT8, 0,  false, false, ExpectAdjacent },
+};
+
+static const int VerifyBackendCount = sizeof(VerifyBackends) / sizeof(VerifyBackends[0]);
+
+static float Uniform(std::mt19937& random, float lo, float hi)
+{
+    return std::uniform_real_distribution<float>(lo, hi)(random);
+}
+
+// A point in voxel units, mapped to world space the way the voxelizers map it back.
+static void FromVoxels(const CasePod& c, const int extent[3], const float v[3], float* world)
+{
+    for (int a = 0; a < 3; ++a)
+        world[a] = c.Bounds[a] + v[a] * (c.Bounds[a + 3] - c.Bounds[a]) / extent[a];
+}
+
+static void CreateCase(std::mt19937& random, const int extent[3], CasePod& c)
+{
+    // Anything from a hundredth to a thousand units across, anywhere within a few thousand
+    // units of the origin, with a different scale along every axis.
+    for (int a = 0; a < 3; ++a) {
+        float size = powf(10.0f, Uniform(random, -2, 3));
+        float magnitude = powf(10.0f, Uniform(random, -2, 3.5f));
+        c.Bounds[a] = Uniform(random, -magnitude, magnitude);
+        c.Bounds[a + 3] = c.Bounds[a] + size;
+    }
+
+    int triangleCount = 1 + random() % 24;
+    c.Positions.clear();
+    c.Indices.clear();
+    for (int t = 0; t < triangleCount; ++t) {
+        float v[3][3];
+        for (int i = 0; i < 3; ++i)
+            for (int a = 0; a < 3; ++a)
+                v[i][a] = Uniform(random, -0.25f, 1.25f) * extent[a];
+
+        switch (random() % 7)
+        {
+            case 0: // random, partly outside the grid
+                break;
+            case 1: // a point
+                for (int a = 0; a < 3; ++a)
+                    v[1][a] = v[2][a] = v[0][a];
+                break;
+            case 2: // a segment
+                for (int a = 0; a < 3; ++a)
+                    v[2][a] = v[0][a] + 0.375f * (v[1][a] - v[0][a]);
+                break;
+            case 3: // a sliver, with its apex a hair off the opposite edge
+            {
+                float hair = powf(10.0f, Uniform(random, -7, -2));
+                for (int a = 0; a < 3; ++a)
+                    v[2][a] = 0.5f * (v[0][a] + v[1][a]) + hair * Uniform(random, -1, 1);
+                break;
+            }
+            case 4: // on voxel centers and faces, where ties are decided
+                for (int i = 0; i < 3; ++i)
+                    for (int a = 0; a < 3; ++a)
+                        v[i][a] = floorf(v[i][a]) + 0.5f * (random() % 2);
+                break;
+            case 5: // flat against a plane of voxel faces
+            {
+                int a = random() % 3;
+                float face = floorf(Uniform(random, 0, (float) extent[a])) + 0.5f;
+                v[0][a] = v[1][a] = v[2][a] = face;
+                break;
+            }
+            case 6: // across the whole grid
+                for (int a = 0; a < 3; ++a) {
+                    v[0][a] = -0.5f * extent[a];
+                    v[1][a] = (a == t % 3 ? 1.5f : -0.5f) * extent[a];
+                    v[2][a] = (a == (t + 1) % 3 ? 1.5f : 0.5f) * extent[a];
+                }
+                break;
+        }
+
+        for (int i = 0; i < 3; ++i) {
+            float world[3];
+            FromVoxels(c, extent, v[i], world);
+            c.Indices.push_back((VOXuint) (c.Positions.size() / 3));
+            c.Positions.insert(c.Positions.end(), world, world + 3);
+        }
+    }
+}
+
+// The case with at least one of its triangles, and from a 64th to all of the rest, shifted
+// by up to a quarter of the grid along every axis.  Small moves take the incremental
+// voxelizer's partial pass and large ones its full pass.
+static void MoveTriangles(std::mt19937& random, const CasePod& c, CasePod& moved)
+{
+    moved = c;
+    size_t triangleCount = c.Indices.size() / 3;
+    size_t first = random() % triangleCount;
+    unsigned int odds = 1u << (random() % 7);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        if (t != first && random() % odds)
+            continue;
+        for (int a = 0; a < 3; ++a) {
+            float shift = Uniform(random, -0.25f, 0.25f) * (c.Bounds[a + 3] - c.Bounds[a]);
+            for (int i = 0; i < 3; ++i)
+                moved.Positions[c.Indices[t * 3 + i] * 3 + a] += shift;
+        }
+    }
+}
+
+static void ReadVoxels(VOXhandle context, VOXhandle volume, VOXenum type, const int extent[3], std::vector<unsigned char>& voxels)
+{
+    voxels.resize((size_t) extent[0] * extent[1] * extent[2]);
+    if (type != VOX_TYPE_BIT) {
+        voxReadVolume(volume, &voxels[0]);
+        return;
+    }
+    VOXhandle bytes = voxCreateVolume(context, extent[0], extent[1], extent[2], VOX_TYPE_UINT8, VOX_SOURCE_IGNORE_PTR, 0);
+    voxCopy(bytes, volume);
+    voxReadVolume(bytes, &voxels[0]);
+    voxDeleteHandle(bytes);
+}
+
+// With before, the volume is first voxelized from its positions, and then again after the
+// mesh is updated to the case's.
+static void Voxelize(VOXhandle context, const CasePod& c, const CasePod* before, const int extent[3], VOXenum op,
+                     VOXenum type, std::vector<unsigned char>& voxels)
+{
+    const CasePod& first = before ? *before : c;
+    VOXhandle mesh = voxRegisterMeshPtr(context, &first.Positions[0], &first.Indices[0], 3 * sizeof(float), VOX_TYPE_UINT32,
+        (VOXuint) first.Positions.size() / 3, (VOXuint) first.Indices.size() / 3);
+    VOXhandle volume = voxCreateVolume(context, extent[0], extent[1], extent[2], type, VOX_SOURCE_IGNORE_PTR, 0);
+    voxGenerate(volume, VOX_GENERATE_CLEAR);
+    voxVoxelize(mesh, volume, op);
+    if (before) {
+        voxUpdateMesh(mesh, VOX_SOURCE_CPU_MEMORY, (void*) &c.Positions[0]);
+        voxVoxelize(mesh, volume, op);
+    }
+    ReadVoxels(context, volume, type, extent, voxels);
+    voxDeleteHandle(volume);
+    voxDeleteHandle(mesh);
+}
+
+// True if a 6-neighbor of the voxel is set.  Neighbors outside the grid might have been, so
+// they count as set.
+static bool NextTo(const std::vector<unsigned char>& voxels, const int extent[3], int x, int y, int z)
+{
+    const int steps[6][3] = { { -1, 0, 0 }, { 1, 0, 0 }, { 0, -1, 0 }, { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 } };
+    for (int s = 0; s < 6; ++s) {
+        int nx = x + steps[s][0], ny = y + steps[s][1], nz = z + steps[s][2];
+        if (nx < 0 || ny < 0 || nz < 0 || nx >= extent[0] || ny >= extent[1] || nz >= extent[2] ||
+            voxels[((size_t) nz * extent[1] + ny) * extent[0] + nx])
+            return true;
+    }
+    return false;
+}
+
+static void Compare(const std::vector<unsigned char>& inner, const std::vector<unsigned char>& outer,
+                    const std::vector<unsigned char>& voxels, const std::vector<unsigned char>* rebuilt,
+                    const int extent[3], Expectation expect, unsigned int seed, VerifyResultPod& result)
+{
+    unsigned long long missing = 0, extra = 0, stray = 0, rebuild = 0;
+    size_t i = 0;
+    for (int z = 0; z < extent[2]; ++z)
+        for (int y = 0; y < extent[1]; ++y)
+            for (int x = 0; x < extent[0]; ++x, ++i) {
+                missing += inner[i] && !voxels[i];
+                rebuild += rebuilt && (*rebuilt)[i] != voxels[i];
+                if (voxels[i] && !outer[i]) {
+                    extra++;
+                    stray += !NextTo(outer, extent, x, y, z);
+                }
+            }
+    result.Missing += missing;
+    result.Extra += extra;
+    result.Stray += stray;
+    result.Rebuild += rebuild;
+    if ((expect == ExpectSuperset && missing) || (expect == ExpectAdjacent && stray) || rebuild) {
+        if (!result.Failures)
+            result.FirstFailure = seed;
+        result.Failures++;
+    }
+}
+
+// Runs the given number of cases, seeded seed, seed + 1, and so on, writes a JSON report, and
+// returns the number of failing backends.
+int VerifyVoxelizers(int cases, unsigned int seed, float tolerance, int width, int height, int depth,
+                     bool useOpenCL, const char* kernelFolder, void (*handleError)(const char*, void*), FILE* file)
+{
+    const int extent[3] = { width, height, depth };
+    const VOXuint simdWidths[] = { 0, 1, 8, 16 };
+    VOXhandle contexts[4];
+    for (int i = 0; i < 4; ++i) {
+        voxSetParam1ui(VOX_PARAM_SIMD_WIDTH, simdWidths[i]);
+        contexts[i] = voxCreateContext(handleError, 0);
+    }
+    voxResetParamv(VOX_PARAM_SIMD_WIDTH);
+
+    std::vector<VerifyResultPod> results(VerifyBackendCount + 1);
+    for (size_t b = 0; b < results.size(); ++b) {
+        results[b].Failures = 0;
+        results[b].Missing = results[b].Extra = results[b].Stray = results[b].Rebuild = 0;
+        results[b].FirstFailure = -1;
+    }
+
+#ifdef BENCHMARK_OPENCL
+    if (useOpenCL)
+        InitHeadlessOpenCL(width, height, depth, kernelFolder);
+#else
+    (void) kernelFolder;
+#endif
+
+    unsigned long long referenceVoxels = 0;
+    std::vector<unsigned char> inner, outer, voxels, rebuilt;
+    for (int n = 0; n < cases; ++n) {
+        std::mt19937 random(seed + n);
+        CasePod c, moved;
+        CreateCase(random, extent, c);
+        MoveTriangles(random, c, moved);
+        voxSetParamfv(VOX_PARAM_VOXELIZE_BOUNDS, c.Bounds);
+
+        voxSetParam1f(VOX_PARAM_REFERENCE_MARGIN, -tolerance);
+        Voxelize(contexts[0], c, 0, extent, VOX_VOXELIZE_SURFACE_REFERENCE, VOX_TYPE_UINT8, inner);
+        voxSetParam1f(VOX_PARAM_REFERENCE_MARGIN, tolerance);
+        Voxelize(contexts[0], c, 0, extent, VOX_VOXELIZE_SURFACE_REFERENCE, VOX_TYPE_UINT8, outer);
+        voxResetParamv(VOX_PARAM_REFERENCE_MARGIN);
+        referenceVoxels += inner.size() - std::count(inner.begin(), inner.end(), 0);
+
+        for (int b = 0; b < VerifyBackendCount; ++b) {
+            const VerifyBackendPod& backend = VerifyBackends[b];
+            VOXhandle context = contexts[std::find(simdWidths, simdWidths + 4, backend.SimdWidth) - simdWidths];
+            voxSetParam1ui(VOX_PARAM_VOLUME_STORAGE, backend.Storage);
+            voxSetParam1b(VOX_PARAM_PLANE_SPANS, backend.PlaneSpans);
+            voxSetParam1b(VOX_PARAM_INCREMENTAL, backend.Incremental);
+            Voxelize(context, c, backend.Incremental ? &moved : 0, extent, backend.Op, backend.Type, voxels);
+            if (backend.Incremental)
+                Voxelize(context, c, 0, extent, backend.Op, backend.Type, rebuilt);
+            Compare(inner, outer, voxels, backend.Incremental ? &rebuilt : 0, extent, backend.Expect, seed + n, results[b]);
+        }
+        voxResetParamv(VOX_PARAM_VOLUME_STORAGE);
+        voxResetParamv(VOX_PARAM_PLANE_SPANS);
+        voxResetParamv(VOX_PARAM_INCREMENTAL);
+
+#ifdef BENCHMARK_OPENCL
+        // The OpenCL volume comes back with its slices in reverse, like the textures.
+        if (useOpenCL) {
+            int mesh = AddHeadlessMesh(&c.Positions[0], (unsigned int) c.Positions.size() / 3, &c.Indices[0], (unsigned int) c.Indices.size() / 3);
+            std::vector<unsigned char> flipped(inner.size());
+            RunHeadlessOpenCL(Point3(c.Bounds[0], c.Bounds[1], c.Bounds[2]), Point3(c.Bounds[3], c.Bounds[4], c.Bounds[5]), &flipped[0]);
+            RemoveOpenCL(mesh);
+            size_t slice = (size_t) width * height;
+            voxels.resize(inner.size());
+            for (int z = 0; z < depth; ++z)
+                std::copy(flipped.begin() + (depth - 1 - z) * slice, flipped.begin() + (depth - z) * slice, voxels.begin() + z * slice);
+            Compare(inner, outer, voxels, 0, extent, ExpectSuperset, seed + n, results[VerifyBackendCount]);
+        }
+#endif
+    }
+    voxResetParamv(VOX_PARAM_VOXELIZE_BOUNDS);
+
+#ifdef BENCHMARK_OPENCL
+    if (useOpenCL)
+        ClearOpenCL();
+#endif
+    for (int i = 0; i < 4; ++i)
+        voxDeleteHandle(contexts[i]);
+
+    int failing = 0;
+    fprintf(file, "{\n");
+    fprintf(file, "  \"cases\": %d,\n  \"seed\": %u,\n  \"tolerance\": %g,\n  \"width\": %d,\n  \"height\": %d,\n  \"depth\": %d,\n",
+        cases, seed, tolerance, width, height, depth);
+    fprintf(file, "  \"reference_voxels\": %llu,\n", referenceVoxels);
+    fprintf(file, "  \"backends\": [\n");
+    int count = VerifyBackendCount + (useOpenCL ? 1 : 0);
+    for (int b = 0; b < count; ++b) {
+        const VerifyResultPod& r = results[b];
+        const char* name = b < VerifyBackendCount ? VerifyBackends[b].Name : "opencl";
+        Expectation expect = b < VerifyBackendCount ? VerifyBackends[b].Expect : ExpectSuperset;
+        fprintf(file, "    { \"backend\": \"%s\", \"expect\": \"%s\", \"failures\": %u, \"missing\": %llu, \"extra\": %llu, \"stray\": %llu, \"rebuild\": %llu, ",
+            name, expect == ExpectSuperset ? "superset" : "adjacent", r.Failures, r.Missing, r.Extra, r.Stray, r.Rebuild);
+        if (r.FirstFailure >= 0)
+            fprintf(file, "\"first_failure_seed\": %lld }%s\n", r.FirstFailure, b + 1 < count ? "," : "");
+        else
+            fprintf(file, "\"first_failure_seed\": null }%s\n", b + 1 < count ? "," : "");
+        failing += r.Failures != 0;
+    }
+    fprintf(file, "  ]\n}\n");
+    return failing;
+}
@@ -0,0 +1,507 @@
+#include <openvox.h>
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Differential testing of voxTransform against brute force on small volumes of random
+// extents, down to a single voxel along an axis.  Every case checks:
+//
+//   - the exact distance transforms, in all three metrics, against the distance to every
+//     non-zero voxel in turn, from dense, sparse and hash sources, and rounded into UINT8;
+//   - gradients, their lengths and normals, and curls, against central differences inside
+//     and one-sided ones on the faces;
+//   - advection, with and without obstacles, against a trilinear lookup at every voxel's
+//     back-traced center;
+//   - narrow-band signed distances around a voxelized sphere: every sign, from the flood
+//     fill and from a solid sign volume, and the magnitudes against the exact distance to
+//     the shell's voxel centers.  The first-order sweeps treat the shell as a continuous
+//     front, so they miss that by up to about half a voxel either way within 5 voxels of
+//     it; the check allows three quarters.
+
+struct TransformCheckPod {
+    const char* Name;
+    double Tolerance;
+};
+
+struct TransformResultPod {
+    unsigned int Failures;
+    double MaxError;        // the largest difference from brute force, or wrong signs
+    long long FirstFailure; // seed of the first failing case, or -1
+};
+
+enum TransformCheck {
+    CheckEuclidean,                    // dense, sparse and hash sources, in that order
+    CheckSqrEuclidean = CheckEuclidean + 3,
+    CheckManhattan = CheckSqrEuclidean + 3,
+    CheckDistanceUint8 = CheckManhattan + 3,
+    CheckGradient,
+    CheckGradientLength,
+    CheckGradientNormals,
+    CheckCurl,
+    CheckAdvect,
+    CheckAdvectObstacles,
+    CheckBandSign,
+    CheckBandSignVolume,
+    CheckBandMagnitude,
+    CheckCount
+};
+
+static const TransformCheckPod TransformChecks[CheckCount] = {
+    { "distance-euclidean-dense",      1e-5 },
+    { "distance-euclidean-sparse",     1e-5 },
+    { "distance-euclidean-hash",       1e-5 },
+    { "distance-sqr-euclidean-dense",  0 },
+    { "distance-sqr-euclidean-sparse", 0 },
+    { "distance-sqr-euclidean-hash",   0 },
+    { "distance-manhattan-dense",      0 },
+    { "distance-manhattan-sparse",     0 },
+    { "distance-manhattan-hash",       0 },
+    { "distance-uint8",                0 },
+    { "gradient",                      1e-5 },
+    { "gradient-length",               1e-5 },
+    { "gradient-normals",              1e-5 },
+    { "curl",                          1e-5 },
+    { "advect",                        1e-5 },
+    { "advect-obstacles",              1e-5 },
+    { "narrow-band-sign",              0 },
+    { "narrow-band-sign-volume",       0 },
+    { "narrow-band-magnitude",         0.75 },
+};
+
+static const VOXenum SourceStorages[3] = { VOX_STORAGE_DENSE, VOX_STORAGE_SPARSE, VOX_STORAGE_HASH };
+
+static float Uniform(std::mt19937& random, float lo, float hi)
+{
+    return std::uniform_real_distribution<float>(lo, hi)(random);
+}
+
+static void RandomExtent(std::mt19937& random, int extent[3])
+{
+    for (int a = 0; a < 3; ++a)
+        extent[a] = 1 + random() % 16;
+}
+
+static size_t VoxelCount(const int extent[3])
+{
+    return (size_t) extent[0] * extent[1] * extent[2];
+}
+
+static size_t Index(const int extent[3], const int p[3])
+{
+    return p[0] + extent[0] * (p[1] + (size_t) extent[1] * p[2]);
+}
+
+static void Coordinates(const int extent[3], size_t i, int p[3])
+{
+    p[0] = (int) (i % extent[0]);
+    p[1] = (int) (i / extent[0] % extent[1]);
+    p[2] = (int) (i / extent[0] / extent[1]);
+}
+
+static VOXhandle CreateVolume(VOXhandle context, const int extent[3], VOXenum type, VOXenum storage, const void* data)
+{
+    voxSetParam1ui(VOX_PARAM_VOLUME_STORAGE, storage);
+    VOXhandle volume = voxCreateVolume(context, extent[0], extent[1], extent[2], type, VOX_SOURCE_IGNORE_PTR, 0);
+    voxResetParamv(VOX_PARAM_VOLUME_STORAGE);
+    if (data)
+        voxUpdateVolume(volume, VOX_SOURCE_CPU_MEMORY, (void*) data);
+    return volume;
+}
+
+template<class T> static void ReadBack(VOXhandle volume, size_t count, std::vector<T>& values)
+{
+    values.resize(count);
+    voxReadVolume(volume, &values[0]);
+}
+
+// Infinite expectations are only met by positive infinity.
+static double Difference(float actual, double expected)
+{
+    if (isinf(expected))
+        return actual == expected ? 0 : HUGE_VAL;
+    return fabs(actual - expected);
+}
+
+static void Record(TransformResultPod& result, double error, double tolerance, long long seed)
+{
+    result.MaxError = std::max(result.MaxError, error);
+    if (!(error <= tolerance)) {
+        if (!result.Failures)
+            result.FirstFailure = seed;
+        result.Failures++;
+    }
+}
+
+// Scattered features, and now and then none at all, where every distance is infinite.
+static void CheckDistances(VOXhandle context, std::mt19937& random, long long seed, std::vector<TransformResultPod>& results)
+{
+    int extent[3];
+    RandomExtent(random, extent);
+    const size_t count = VoxelCount(extent);
+    float density = random() % 8 ? Uniform(random, 0.0f, 0.2f) : 0.0f;
+    std::vector<unsigned char> features(count);
+    for (size_t i = 0; i < count; ++i)
+        features[i] = Uniform(random, 0, 1) < density ? (unsigned char) (1 + random() % 255) : 0;
+
+    std::vector<double> squared(count, HUGE_VAL), manhattan(count, HUGE_VAL);
+    for (size_t i = 0; i < count; ++i) {
+        int p[3];
+        Coordinates(extent, i, p);
+        for (size_t j = 0; j < count; ++j) {
+            if (!features[j])
+                continue;
+            int q[3];
+            Coordinates(extent, j, q);
+            double dx = p[0] - q[0], dy = p[1] - q[1], dz = p[2] - q[2];
+            squared[i] = std::min(squared[i], dx * dx + dy * dy + dz * dz);
+            manhattan[i] = std::min(manhattan[i], fabs(dx) + fabs(dy) + fabs(dz));
+        }
+    }
+
+    static const VOXenum metrics[3] = { VOX_TRANSFORM_DISTANCE_EUCLIDEAN, VOX_TRANSFORM_DISTANCE_SQR_EUCLIDEAN, VOX_TRANSFORM_DISTANCE_MANHATTAN };
+    VOXhandle dest = CreateVolume(context, extent, VOX_TYPE_FLOAT32, VOX_STORAGE_DENSE, 0);
+    std::vector<float> distances;
+    for (int s = 0; s < 3; ++s) {
+        VOXhandle src = CreateVolume(context, extent, VOX_TYPE_UINT8, SourceStorages[s], &features[0]);
+        for (int m = 0; m < 3; ++m) {
+            voxTransform(dest, src, metrics[m]);
+            ReadBack(dest, count, distances);
+            double error = 0;
+            for (size_t i = 0; i < count; ++i) {
+                double expected = m == 0 ? sqrt(squared[i]) : m == 1 ? squared[i] : manhattan[i];
+                error = std::max(error, Difference(distances[i], expected));
+            }
+            int check = CheckEuclidean + 3 * m + s;
+            Record(results[check], error, TransformChecks[check].Tolerance, seed);
+        }
+        voxDeleteHandle(src);
+    }
+    voxDeleteHandle(dest);
+
+    // Integer destinations round to nearest and saturate, infinity included.
+    VOXhandle src = CreateVolume(context, extent, VOX_TYPE_UINT8, VOX_STORAGE_DENSE, &features[0]);
+    dest = CreateVolume(context, extent, VOX_TYPE_UINT8, VOX_STORAGE_DENSE, 0);
+    voxTransform(dest, src, VOX_TRANSFORM_DISTANCE_EUCLIDEAN);
+    std::vector<unsigned char> bytes;
+    ReadBack(dest, count, bytes);
+    double error = 0;
+    for (size_t i = 0; i < count; ++i) {
+        float d = (float) sqrt(squared[i]);
+        int expected = d < 255 ? (int) (d + 0.5f) : 255;
+        error = std::max(error, (double) abs(bytes[i] - expected));
+    }
+    Record(results[CheckDistanceUint8], error, TransformChecks[CheckDistanceUint8].Tolerance, seed);
+    voxDeleteHandle(src);
+    voxDeleteHandle(dest);
+}
+
+// Central differences inside, one-sided on the faces, and zero along single-voxel axes.
+static double Derivative(const std::vector<float>& field, int components, int component, const int extent[3], const int p[3], int axis)
+{
+    int lo[3] = { p[0], p[1], p[2] }, hi[3] = { p[0], p[1], p[2] };
+    lo[axis] = std::max(p[axis] - 1, 0);
+    hi[axis] = std::min(p[axis] + 1, extent[axis] - 1);
+    if (hi[axis] == lo[axis])
+        return 0;
+    return ((double) field[Index(extent, hi) * components + component] - field[Index(extent, lo) * components + component]) /
+           (hi[axis] - lo[axis]);
+}
+
+// Normals are compared scaled by the gradient's length, which keeps rounding in gradients
+// near zero from being blown up by the normalization.
+static void CheckStencils(VOXhandle context, std::mt19937& random, long long seed, std::vector<TransformResultPod>& results)
+{
+    int extent[3];
+    RandomExtent(random, extent);
+    const size_t count = VoxelCount(extent);
+    std::vector<float> scalars(count), vectors(count * 4);
+    for (size_t i = 0; i < count; ++i)
+        scalars[i] = Uniform(random, -1, 1);
+    for (size_t i = 0; i < count * 4; ++i)
+        vectors[i] = Uniform(random, -1, 1);
+
+    std::vector<double> gradients(count * 4), curls(count * 4);
+    for (size_t i = 0; i < count; ++i) {
+        int p[3];
+        Coordinates(extent, i, p);
+        double* g = &gradients[i * 4];
+        for (int a = 0; a < 3; ++a)
+            g[a] = Derivative(scalars, 1, 0, extent, p, a);
+        g[3] = sqrt(g[0] * g[0] + g[1] * g[1] + g[2] * g[2]);
+
+        double* c = &curls[i * 4];
+        c[0] = Derivative(vectors, 4, 2, extent, p, 1) - Derivative(vectors, 4, 1, extent, p, 2);
+        c[1] = Derivative(vectors, 4, 0, extent, p, 2) - Derivative(vectors, 4, 2, extent, p, 0);
+        c[2] = Derivative(vectors, 4, 1, extent, p, 0) - Derivative(vectors, 4, 0, extent, p, 1);
+        c[3] = sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]);
+    }
+
+    VOXenum storage = random() % 2 ? VOX_STORAGE_SPARSE : VOX_STORAGE_DENSE;
+    VOXhandle scalar = CreateVolume(context, extent, VOX_TYPE_FLOAT32, storage, &scalars[0]);
+    VOXhandle vector = CreateVolume(context, extent, VOX_TYPE_FLOAT32X4, storage, &vectors[0]);
+    VOXhandle dest4 = CreateVolume(context, extent, VOX_TYPE_FLOAT32X4, VOX_STORAGE_DENSE, 0);
+    VOXhandle dest1 = CreateVolume(context, extent, VOX_TYPE_FLOAT32, VOX_STORAGE_DENSE, 0);
+    std::vector<float> out;
+
+    voxTransform(dest4, scalar, VOX_TRANSFORM_GRADIENT);
+    ReadBack(dest4, count * 4, out);
+    double error = 0;
+    for (size_t i = 0; i < count * 4; ++i)
+        error = std::max(error, Difference(out[i], gradients[i]));
+    Record(results[CheckGradient], error, TransformChecks[CheckGradient].Tolerance, seed);
+
+    voxTransform(dest1, scalar, VOX_TRANSFORM_GRADIENT);
+    ReadBack(dest1, count, out);
+    error = 0;
+    for (size_t i = 0; i < count; ++i)
+        error = std::max(error, Difference(out[i], gradients[i * 4 + 3]));
+    Record(results[CheckGradientLength], error, TransformChecks[CheckGradientLength].Tolerance, seed);
+
+    voxTransform(dest4, scalar, VOX_TRANSFORM_GRADIENT_NORMALS);
+    ReadBack(dest4, count * 4, out);
+    error = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const double* g = &gradients[i * 4];
+        for (int c = 0; c < 3; ++c)
+            error = std::max(error, fabs(out[i * 4 + c] * g[3] + g[c]) * std::min(g[3], 1.0) / std::max(g[3], 1.0));
+        error = std::max(error, Difference(out[i * 4 + 3], g[3]));
+    }
+    Record(results[CheckGradientNormals], error, TransformChecks[CheckGradientNormals].Tolerance, seed);
+
+    voxTransform(dest4, vector, VOX_TRANSFORM_CURL);
+    ReadBack(dest4, count * 4, out);
+    error = 0;
+    for (size_t i = 0; i < count * 4; ++i)
+        error = std::max(error, Difference(out[i], curls[i]));
+    Record(results[CheckCurl], error, TransformChecks[CheckCurl].Tolerance, seed);
+
+    voxDeleteHandle(scalar);
+    voxDeleteHandle(vector);
+    voxDeleteHandle(dest4);
+    voxDeleteHandle(dest1);
+}
+
+// Where a back-traced coordinate lands along one axis, clamped to the outermost centers.
+static void Locate(float p, int extent, int& lo, int& hi, double& t)
+{
+    p = std::min(std::max(p, 0.0f), (float) (extent - 1));
+    lo = std::min((int) floorf(p), std::max(extent - 2, 0));
+    hi = extent > 1 ? lo + 1 : lo;
+    t = p - lo;
+}
+
+// Each voxel's center traced back along velocity, and the source blended there.  Obstacle
+// voxels are zero, obstacle corners drop out of the blend, and voxels with nothing but
+// obstacle corners keep their value.
+static void Advect(const std::vector<float>& quantity, int components, const std::vector<float>& velocity,
+                   const std::vector<unsigned char>* obstacles, const int extent[3], float timeStep, std::vector<double>& out)
+{
+    const size_t count = VoxelCount(extent);
+    out.assign(count * components, 0);
+    for (size_t i = 0; i < count; ++i) {
+        if (obstacles && (*obstacles)[i])
+            continue;
+        int p[3], lo[3], hi[3];
+        double t[3];
+        Coordinates(extent, i, p);
+        for (int a = 0; a < 3; ++a)
+            Locate(p[a] - timeStep * velocity[i * 4 + a], extent[a], lo[a], hi[a], t[a]);
+
+        size_t corners[8];
+        double weights[8], total = 0;
+        for (int k = 0; k < 8; ++k) {
+            int q[3] = { k & 1 ? hi[0] : lo[0], k & 2 ? hi[1] : lo[1], k & 4 ? hi[2] : lo[2] };
+            corners[k] = Index(extent, q);
+            weights[k] = (k & 1 ? t[0] : 1 - t[0]) * (k & 2 ? t[1] : 1 - t[1]) * (k & 4 ? t[2] : 1 - t[2]);
+            if (obstacles && (*obstacles)[corners[k]])
+                weights[k] = 0;
+            total += weights[k];
+        }
+        for (int c = 0; c < components; ++c) {
+            if (total == 0) {
+                out[i * components + c] = quantity[i * components + c];
+                continue;
+            }
+            for (int k = 0; k < 8; ++k)
+                out[i * components + c] += weights[k] / total * quantity[corners[k] * components + c];
+        }
+    }
+}
+
+// Half the cases move a scalar along a separate velocity volume, and half a vector volume
+// along itself.
+static void CheckAdvection(VOXhandle context, std::mt19937& random, long long seed, std::vector<TransformResultPod>& results)
+{
+    int extent[3];
+    RandomExtent(random, extent);
+    const size_t count = VoxelCount(extent);
+    const bool self = random() % 2 != 0;
+    const int components = self ? 4 : 1;
+    std::vector<float> quantity(count * components), velocity(count * 4);
+    std::vector<unsigned char> obstacles(count);
+    for (size_t i = 0; i < count * 4; ++i)
+        velocity[i] = Uniform(random, -3, 3);
+    for (size_t i = 0; i < count * components; ++i)
+        quantity[i] = self ? velocity[i] : Uniform(random, -1, 1);
+    for (size_t i = 0; i < count; ++i)
+        obstacles[i] = random() % 4 == 0;
+    float timeStep = Uniform(random, -1.5f, 1.5f);
+    if (fabsf(timeStep) < 0.1f)
+        timeStep = 1;
+
+    VOXenum type = self ? VOX_TYPE_FLOAT32X4 : VOX_TYPE_FLOAT32;
+    VOXenum storage = random() % 2 ? VOX_STORAGE_SPARSE : VOX_STORAGE_DENSE;
+    VOXhandle src = CreateVolume(context, extent, type, storage, &quantity[0]);
+    VOXhandle flow = self ? 0 : CreateVolume(context, extent, VOX_TYPE_FLOAT32X4, VOX_STORAGE_DENSE, &velocity[0]);
+    VOXhandle walls = CreateVolume(context, extent, VOX_TYPE_UINT8, VOX_STORAGE_DENSE, &obstacles[0]);
+    VOXhandle dest = CreateVolume(context, extent, type, VOX_STORAGE_DENSE, 0);
+    voxSetParam1h(VOX_PARAM_FLUID_VELOCITY, flow);
+    voxSetParam1f(VOX_PARAM_FLUID_TIME_STEP, timeStep);
+
+    std::vector<float> out;
+    std::vector<double> expected;
+    for (int pass = 0; pass < 2; ++pass) {
+        voxSetParam1h(VOX_PARAM_FLUID_OBSTACLES, pass ? walls : 0);
+        voxTransform(dest, src, VOX_TRANSFORM_FLUID_ADVECT);
+        ReadBack(dest, count * components, out);
+        Advect(quantity, components, velocity, pass ? &obstacles : 0, extent, timeStep, expected);
+        double error = 0;
+        for (size_t i = 0; i < count * components; ++i)
+            error = std::max(error, Difference(out[i], expected[i]));
+        int check = pass ? CheckAdvectObstacles : CheckAdvect;
+        Record(results[check], error, TransformChecks[check].Tolerance, seed);
+    }
+
+    voxResetParamv(VOX_PARAM_FLUID_OBSTACLES);
+    voxResetParamv(VOX_PARAM_FLUID_VELOCITY);
+    voxResetParamv(VOX_PARAM_FLUID_TIME_STEP);
+    voxDeleteHandle(src);
+    if (flow)
+        voxDeleteHandle(flow);
+    voxDeleteHandle(walls);
+    voxDeleteHandle(dest);
+}
+
+// Number of voxels whose signed distance has the wrong sign: negative strictly inside the
+// sphere, positive strictly outside, and zero on the shell.
+static double CountWrongSigns(const std::vector<float>& distances, const std::vector<unsigned char>& shell,
+                              const std::vector<unsigned char>& solid)
+{
+    double wrong = 0;
+    for (size_t i = 0; i < distances.size(); ++i) {
+        if (shell[i])
+            wrong += distances[i] != 0;
+        else
+            wrong += solid[i] ? !(distances[i] < 0) : !(distances[i] > 0);
+    }
+    return wrong;
+}
+
+// The shell is every voxel whose center is within half a voxel diagonal of the sphere, so
+// it holds every voxel the sphere passes through and nothing leaks across it.  The sphere
+// stays clear of the faces, so that the flood fill finds the inside sealed.
+static void CheckNarrowBand(VOXhandle context, std::mt19937& random, long long seed, std::vector<TransformResultPod>& results)
+{
+    int extent[3];
+    for (int a = 0; a < 3; ++a)
+        extent[a] = 12 + random() % 14;
+    float center[3], radius = HUGE_VALF;
+    for (int a = 0; a < 3; ++a) {
+        center[a] = Uniform(random, 0.4f, 0.6f) * (extent[a] - 1);
+        radius = std::min(radius, std::min(center[a], extent[a] - 1 - center[a]) - 1.5f);
+    }
+    radius = Uniform(random, 2.5f, radius);
+    const float band = Uniform(random, 1.5f, 5.0f);
+
+    const size_t count = VoxelCount(extent);
+    std::vector<unsigned char> shell(count), solid(count);
+    for (size_t i = 0; i < count; ++i) {
+        int p[3];
+        Coordinates(extent, i, p);
+        float dx = p[0] - center[0], dy = p[1] - center[1], dz = p[2] - center[2];
+        float r = sqrtf(dx * dx + dy * dy + dz * dz);
+        shell[i] = fabsf(r - radius) <= 0.8660254f;
+        solid[i] = r < radius;
+    }
+
+    std::vector<double> expected(count, HUGE_VAL);
+    for (size_t i = 0; i < count; ++i) {
+        int p[3];
+        Coordinates(extent, i, p);
+        for (size_t j = 0; j < count; ++j) {
+            if (!shell[j])
+                continue;
+            int q[3];
+            Coordinates(extent, j, q);
+            double dx = p[0] - q[0], dy = p[1] - q[1], dz = p[2] - q[2];
+            expected[i] = std::min(expected[i], sqrt(dx * dx + dy * dy + dz * dz));
+        }
+        expected[i] = std::min(expected[i], (double) band);
+    }
+
+    VOXhandle src = CreateVolume(context, extent, VOX_TYPE_UINT8, SourceStorages[random() % 3], &shell[0]);
+    VOXhandle sign = CreateVolume(context, extent, VOX_TYPE_UINT8, VOX_STORAGE_DENSE, &solid[0]);
+    VOXhandle dest = CreateVolume(context, extent, VOX_TYPE_FLOAT32, VOX_STORAGE_DENSE, 0);
+    voxSetParam1f(VOX_PARAM_NARROW_BAND, band);
+    std::vector<float> distances;
+
+    voxTransform(dest, src, VOX_TRANSFORM_DISTANCE_NARROW_BAND);
+    ReadBack(dest, count, distances);
+    Record(results[CheckBandSign], CountWrongSigns(distances, shell, solid), TransformChecks[CheckBandSign].Tolerance, seed);
+    double error = 0;
+    for (size_t i = 0; i < count; ++i)
+        error = std::max(error, Difference(fabsf(distances[i]), expected[i]));
+    Record(results[CheckBandMagnitude], error, TransformChecks[CheckBandMagnitude].Tolerance, seed);
+
+    voxSetParam1h(VOX_PARAM_SIGN_VOLUME, sign);
+    voxTransform(dest, src, VOX_TRANSFORM_DISTANCE_NARROW_BAND);
+    ReadBack(dest, count, distances);
+    Record(results[CheckBandSignVolume], CountWrongSigns(distances, shell, solid), TransformChecks[CheckBandSignVolume].Tolerance, seed);
+
+    voxResetParamv(VOX_PARAM_SIGN_VOLUME);
+    voxResetParamv(VOX_PARAM_NARROW_BAND);
+    voxDeleteHandle(src);
+    voxDeleteHandle(sign);
+    voxDeleteHandle(dest);
+}
+
+// Runs the given number of cases, seeded seed, seed + 1, and so on, writes a JSON report, and
+// returns the number of failing checks.
+int VerifyTransforms(int cases, unsigned int seed, void (*handleError)(const char*, void*), FILE* file)
+{
+    VOXhandle context = voxCreateContext(handleError, 0);
+    std::vector<TransformResultPod> results(CheckCount);
+    for (size_t c = 0; c < results.size(); ++c) {
+        results[c].Failures = 0;
+        results[c].MaxError = 0;
+        results[c].FirstFailure = -1;
+    }
+
+    for (int n = 0; n < cases; ++n) {
+        std::mt19937 random(seed + n);
+        CheckDistances(context, random, seed + n, results);
+        CheckStencils(context, random, seed + n, results);
+        CheckAdvection(context, random, seed + n, results);
+        CheckNarrowBand(context, random, seed + n, results);
+    }
+    voxDeleteHandle(context);
+
+    int failing = 0;
+    fprintf(file, "{\n");
+    fprintf(file, "  \"cases\": %d,\n  \"seed\": %u,\n", cases, seed);
+    fprintf(file, "  \"checks\": [\n");
+    for (int c = 0; c < CheckCount; ++c) {
+        const TransformResultPod& r = results[c];
+        fprintf(file, "    { \"check\": \"%s\", \"tolerance\": %g, \"failures\": %u, \"max_error\": %g, ",
+            TransformChecks[c].Name, TransformChecks[c].Tolerance, r.Failures, r.MaxError);
+        if (r.FirstFailure >= 0)
+            fprintf(file, "\"first_failure_seed\": %lld }%s\n", r.FirstFailure, c + 1 < CheckCount ? "," : "");
+        else
+            fprintf(file, "\"first_failure_seed\": null }%s\n", c + 1 < CheckCount ? "," : "");
+        failing += r.Failures != 0;
+    }
+    fprintf(file, "  ]\n}\n");
+    return failing;
+}
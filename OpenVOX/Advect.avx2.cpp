@@ -0,0 +1,106 @@
+#include "Common.hpp"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+
+namespace OpenVOX {
+
+// Same step as AdvectRowScalar for eight voxels at a time: the back-traced positions are
+// computed side by side and the eight corners of all of them fetched with gathers.  Vector
+// sources, whose corners are a whole SSE load each, and volumes too large for 32-bit gather
+// indices are left to the scalar row.
+void AdvectRowAvx2(const AdvectPod& job, int x, int count, int y, int z, float* dest)
+{
+    const FieldView& q = job.Source;
+    const int* extent = job.Extent;
+    if (q.Components != 1 || (size_t) extent[0] * extent[1] * extent[2] > 0x7fffffff) {
+        AdvectRowScalar(job, x, count, y, z, dest);
+        return;
+    }
+
+    const float* velocity = job.Velocity.Base + (y * job.Velocity.Row + z * job.Velocity.Slice) * 4;
+    const ptrdiff_t row = y * q.Row + z * q.Slice;
+
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 dt = _mm256_set1_ps(job.TimeStep);
+    const __m256 lanes = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256 cy = _mm256_set1_ps((float) y), cz = _mm256_set1_ps((float) z);
+    const __m256 maxX = _mm256_set1_ps((float) (extent[0] - 1));
+    const __m256 maxY = _mm256_set1_ps((float) (extent[1] - 1));
+    const __m256 maxZ = _mm256_set1_ps((float) (extent[2] - 1));
+    const __m256i lastX = _mm256_set1_epi32(extent[0] > 1 ? extent[0] - 2 : 0);
+    const __m256i lastY = _mm256_set1_epi32(extent[1] > 1 ? extent[1] - 2 : 0);
+    const __m256i lastZ = _mm256_set1_epi32(extent[2] > 1 ? extent[2] - 2 : 0);
+    const __m256i rowStride = _mm256_set1_epi32((int) q.Row);
+    const __m256i sliceStride = _mm256_set1_epi32((int) q.Slice);
+    const __m256i velocityIndex = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+
+    // Offsets of the other seven corners from the lower one.
+    const int sx = extent[0] > 1 ? 1 : 0;
+    const int sy = extent[1] > 1 ? (int) q.Row : 0;
+    const int sz = extent[2] > 1 ? (int) q.Slice : 0;
+    const __m256i o1 = _mm256_set1_epi32(sx), o2 = _mm256_set1_epi32(sy), o3 = _mm256_set1_epi32(sx + sy);
+    const __m256i o4 = _mm256_set1_epi32(sz), o5 = _mm256_set1_epi32(sx + sz), o6 = _mm256_set1_epi32(sy + sz);
+    const __m256i o7 = _mm256_set1_epi32(sx + sy + sz);
+
+    const int start = x, end = x + count;
+    for (; x + 8 <= end; x += 8) {
+        const float* u = velocity + x * 4;
+        __m256 ux = _mm256_i32gather_ps(u, velocityIndex, 4);
+        __m256 uy = _mm256_i32gather_ps(u + 1, velocityIndex, 4);
+        __m256 uz = _mm256_i32gather_ps(u + 2, velocityIndex, 4);
+
+        // Back-traced and clamped; max returns its second operand for NaNs, so they land on 0.
+        __m256 px = _mm256_sub_ps(_mm256_add_ps(_mm256_set1_ps((float) x), lanes), _mm256_mul_ps(dt, ux));
+        __m256 py = _mm256_sub_ps(cy, _mm256_mul_ps(dt, uy));
+        __m256 pz = _mm256_sub_ps(cz, _mm256_mul_ps(dt, uz));
+        px = _mm256_min_ps(_mm256_max_ps(px, zero), maxX);
+        py = _mm256_min_ps(_mm256_max_ps(py, zero), maxY);
+        pz = _mm256_min_ps(_mm256_max_ps(pz, zero), maxZ);
+
+        __m256i ix = _mm256_min_epi32(_mm256_cvttps_epi32(px), lastX);
+        __m256i iy = _mm256_min_epi32(_mm256_cvttps_epi32(py), lastY);
+        __m256i iz = _mm256_min_epi32(_mm256_cvttps_epi32(pz), lastZ);
+        __m256 tx = _mm256_sub_ps(px, _mm256_cvtepi32_ps(ix));
+        __m256 ty = _mm256_sub_ps(py, _mm256_cvtepi32_ps(iy));
+        __m256 tz = _mm256_sub_ps(pz, _mm256_cvtepi32_ps(iz));
+        __m256i c0 = _mm256_add_epi32(ix, _mm256_add_epi32(_mm256_mullo_epi32(iy, rowStride), _mm256_mullo_epi32(iz, sliceStride)));
+        __m256i c[8] = { c0, _mm256_add_epi32(c0, o1), _mm256_add_epi32(c0, o2), _mm256_add_epi32(c0, o3),
+                         _mm256_add_epi32(c0, o4), _mm256_add_epi32(c0, o5), _mm256_add_epi32(c0, o6), _mm256_add_epi32(c0, o7) };
+
+        __m256 rx = _mm256_sub_ps(one, tx), ry = _mm256_sub_ps(one, ty), rz = _mm256_sub_ps(one, tz);
+        __m256 wy0z0 = _mm256_mul_ps(ry, rz), wy1z0 = _mm256_mul_ps(ty, rz);
+        __m256 wy0z1 = _mm256_mul_ps(ry, tz), wy1z1 = _mm256_mul_ps(ty, tz);
+        __m256 w[8] = { _mm256_mul_ps(rx, wy0z0), _mm256_mul_ps(tx, wy0z0), _mm256_mul_ps(rx, wy1z0), _mm256_mul_ps(tx, wy1z0),
+                        _mm256_mul_ps(rx, wy0z1), _mm256_mul_ps(tx, wy0z1), _mm256_mul_ps(rx, wy1z1), _mm256_mul_ps(tx, wy1z1) };
+
+        __m256 sum = zero;
+        if (!job.Fluid) {
+            for (int i = 0; i < 8; ++i)
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(w[i], _mm256_i32gather_ps(q.Base, c[i], 4)));
+            _mm256_storeu_ps(dest + (x - start), sum);
+            continue;
+        }
+
+        // Obstacle corners drop out and the others are renormalized; where they all drop out
+        // the voxel keeps its value, and inside obstacles it is zero.
+        __m256 total = zero;
+        for (int i = 0; i < 8; ++i) {
+            __m256 weight = _mm256_mul_ps(w[i], _mm256_i32gather_ps(job.Fluid, c[i], 4));
+            total = _mm256_add_ps(total, weight);
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(weight, _mm256_i32gather_ps(q.Base, c[i], 4)));
+        }
+        __m256 blocked = _mm256_cmp_ps(total, zero, _CMP_EQ_OQ);
+        __m256 value = _mm256_blendv_ps(_mm256_div_ps(sum, total), _mm256_loadu_ps(q.Base + row + x), blocked);
+        __m256 solid = _mm256_cmp_ps(_mm256_loadu_ps(job.Fluid + row + x), zero, _CMP_EQ_OQ);
+        _mm256_storeu_ps(dest + (x - start), _mm256_andnot_ps(solid, value));
+    }
+
+    if (x < end)
+        AdvectRowScalar(job, x, end - x, y, z, dest + (x - start));
+}
+
+} // namespace OpenVOX
+
+#endif
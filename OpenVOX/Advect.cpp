@@ -0,0 +1,202 @@
+#include "Common.hpp"
+#include <string.h>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ADVECT_SSE
+#endif
+
+namespace OpenVOX {
+
+// Semi-Lagrangian advection [Stam, "Stable Fluids"]: every voxel traces its center one time
+// step back along its own velocity and takes the trilinear blend of the source there.
+// Positions are clamped to the centers of the outermost voxels.  With obstacles, corners
+// inside them drop out of the blend and the rest are renormalized, so that nothing is drawn
+// out of the walls; voxels inside obstacles are zero.
+//
+// Dense linear volumes are sampled in place, and anything else is first copied into a
+// scratch field with the same layout.  Rows go to the threads, and each row to the widest
+// row function the processor runs: the AVX2 one gathers the eight corners of eight voxels
+// at a time.
+
+// Where a back-traced coordinate lands along one axis: the offset of the lower corner, the
+// step to the upper one, and the weight of the upper one.  NaNs land on the first voxel.
+static inline void Locate(float p, int extent, ptrdiff_t stride, ptrdiff_t& offset, ptrdiff_t& step, float& t)
+{
+    p = p > 0 ? p : 0;
+    p = p < extent - 1 ? p : (float) (extent - 1);
+    int i = std::min((int) p, std::max(extent - 2, 0));
+    offset = i * stride;
+    step = extent > 1 ? stride : 0;
+    t = p - i;
+}
+
+void AdvectRowScalar(const AdvectPod& job, int x, int count, int y, int z, float* dest)
+{
+    const FieldView& q = job.Source;
+    const int components = q.Components;
+    const float* velocity = job.Velocity.Base + (y * job.Velocity.Row + z * job.Velocity.Slice) * 4;
+    const ptrdiff_t row = y * q.Row + z * q.Slice;
+
+    for (int end = x + count; x < end; ++x, dest += components) {
+        const float* u = velocity + x * 4;
+        ptrdiff_t ox, oy, oz, sx, sy, sz;
+        float tx, ty, tz;
+        Locate(x - job.TimeStep * u[0], job.Extent[0], 1, ox, sx, tx);
+        Locate(y - job.TimeStep * u[1], job.Extent[1], q.Row, oy, sy, ty);
+        Locate(z - job.TimeStep * u[2], job.Extent[2], q.Slice, oz, sz, tz);
+
+        const ptrdiff_t corner = ox + oy + oz;
+        const ptrdiff_t offsets[8] = { 0, sx, sy, sx + sy, sz, sx + sz, sy + sz, sx + sy + sz };
+        float w[8] = {
+            (1 - tx) * (1 - ty) * (1 - tz), tx * (1 - ty) * (1 - tz), (1 - tx) * ty * (1 - tz), tx * ty * (1 - tz),
+            (1 - tx) * (1 - ty) * tz,       tx * (1 - ty) * tz,       (1 - tx) * ty * tz,       tx * ty * tz };
+
+        if (job.Fluid) {
+            if (job.Fluid[row + x] == 0) {
+                memset(dest, 0, components * sizeof(float));
+                continue;
+            }
+            float total = 0;
+            for (int i = 0; i < 8; ++i)
+                total += w[i] *= job.Fluid[corner + offsets[i]];
+            if (total == 0) {
+                memcpy(dest, q.Base + (row + x) * components, components * sizeof(float));
+                continue;
+            }
+            for (int i = 0; i < 8; ++i)
+                w[i] /= total;
+        }
+
+#ifdef ADVECT_SSE
+        if (components == 4) {
+            __m128 sum = _mm_setzero_ps();
+            for (int i = 0; i < 8; ++i)
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(w[i]), _mm_loadu_ps(q.Base + (corner + offsets[i]) * 4)));
+            _mm_storeu_ps(dest, sum);
+            continue;
+        }
+#endif
+        for (int c = 0; c < components; ++c) {
+            float sum = 0;
+            for (int i = 0; i < 8; ++i)
+                sum += w[i] * q.Base[(corner + offsets[i]) * components + c];
+            dest[c] = sum;
+        }
+    }
+}
+
+AdvectRowFunc ChooseAdvectRow(VOXuint simdWidth)
+{
+    if (simdWidth == 0)
+        simdWidth = 8;
+
+#ifdef OPENVOX_HAVE_AVX2
+    if (simdWidth >= 8 && CpuSupports(8))
+        return AdvectRowAvx2;
+#endif
+    return AdvectRowScalar;
+}
+
+// Dense linear float volumes are used where they are; the rest are read into scratch.
+static FieldView ViewField(ContextPod* context, const VolumePod* volume, std::vector<float>& scratch)
+{
+    const int width = volume->Width, height = volume->Height, depth = volume->Depth;
+    FieldView view;
+    view.Components = volume->BytesPerVoxel / sizeof(float);
+    view.Row = width;
+    if (volume->Data && !volume->Bricks && volume->Layout == VOX_LAYOUT_LINEAR) {
+        view.Base = (const float*) (volume->Data + VoxelOffset(volume, 0, 0, 0));
+        view.Slice = -(ptrdiff_t) width * height;
+        return view;
+    }
+
+    scratch.resize((size_t) width * height * depth * view.Components);
+    ParallelFor(context->Pool, (size_t) height * depth, 16,
+        [&](size_t begin, size_t end, unsigned int) {
+            for (size_t r = begin; r < end; ++r)
+                ReadVoxelSpan(volume, 0, (int) (r % height), (int) (r / height), width,
+                              (unsigned char*) &scratch[r * width * view.Components]);
+        });
+    view.Base = &scratch[0];
+    view.Slice = (ptrdiff_t) width * height;
+    return view;
+}
+
+// 1 where the obstacle volume is zero and 0 elsewhere, laid out like view.
+static const float* ViewFluid(ContextPod* context, const VolumePod* obstacles, const FieldView& view, std::vector<float>& scratch)
+{
+    static const unsigned char zero[16] = { 0 };
+    const int width = obstacles->Width, height = obstacles->Height, depth = obstacles->Depth;
+    const VOXuint bytesPerVoxel = obstacles->BytesPerVoxel ? obstacles->BytesPerVoxel : 1;
+    scratch.resize((size_t) width * height * depth);
+    float* fluid = &scratch[0] + (view.Slice < 0 ? (size_t) (depth - 1) * width * height : 0);
+
+    ParallelFor(context->Pool, (size_t) height * depth, 16,
+        [&](size_t begin, size_t end, unsigned int) {
+            std::vector<unsigned char> row((size_t) width * bytesPerVoxel);
+            for (size_t r = begin; r < end; ++r) {
+                int y = (int) (r % height), z = (int) (r / height);
+                ReadVoxelSpan(obstacles, 0, y, z, width, &row[0]);
+                float* dest = fluid + y * view.Row + z * view.Slice;
+                for (int x = 0; x < width; ++x)
+                    dest[x] = memcmp(&row[x * bytesPerVoxel], zero, bytesPerVoxel) ? 0.0f : 1.0f;
+            }
+        });
+    return fluid;
+}
+
+static bool Matches(const VolumePod* a, const VolumePod* b)
+{
+    return a->Width == b->Width && a->Height == b->Height && a->Depth == b->Depth;
+}
+
+void TransformAdvect(VolumePod* dest, const VolumePod* src)
+{
+    ContextPod* context = dest->Context;
+    const ParamBlock& params = GetParams();
+    if (dest == src || dest->Type != src->Type || (src->Type != VOX_TYPE_FLOAT32 && src->Type != VOX_TYPE_FLOAT32X4) ||
+        dest->Hash || dest->Octree) {
+        ReportError(context, "voxTransform: advection needs a VOX_TYPE_FLOAT32 or VOX_TYPE_FLOAT32X4 source and a separate dense or sparse destination of the same type.\n");
+        return;
+    }
+
+    const VolumePod* velocity = params.FluidVelocity ? CastHandle<VolumePod>(params.FluidVelocity, HandleVolume) : src;
+    if (!velocity || velocity == dest || velocity->Type != VOX_TYPE_FLOAT32X4 || !Matches(velocity, src)) {
+        ReportError(context, "voxTransform: VOX_PARAM_FLUID_VELOCITY must be a VOX_TYPE_FLOAT32X4 volume the size of the source, other than the destination.\n");
+        return;
+    }
+
+    const VolumePod* obstacles = 0;
+    if (params.FluidObstacles) {
+        obstacles = CastHandle<VolumePod>(params.FluidObstacles, HandleVolume);
+        if (!obstacles || obstacles == dest || !Matches(obstacles, src)) {
+            ReportError(context, "voxTransform: VOX_PARAM_FLUID_OBSTACLES must be a volume the size of the source, other than the destination.\n");
+            return;
+        }
+    }
+
+    AdvectPod job;
+    job.Source = ViewField(context, src, context->Quantity);
+    job.Velocity = velocity == src ? job.Source : ViewField(context, velocity, context->Velocity);
+    job.Fluid = obstacles ? ViewFluid(context, obstacles, job.Source, context->Fluid) : 0;
+    job.Extent[0] = src->Width;
+    job.Extent[1] = src->Height;
+    job.Extent[2] = src->Depth;
+    job.TimeStep = params.FluidTimeStep ? params.FluidTimeStep : 1.0f;
+
+    const int width = src->Width, height = src->Height;
+    DetachSources(dest);
+    ParallelFor(context->Pool, (size_t) height * src->Depth, 16,
+        [&](size_t begin, size_t end, unsigned int) {
+            std::vector<float> row((size_t) width * job.Source.Components);
+            for (size_t r = begin; r < end; ++r) {
+                int y = (int) (r % height), z = (int) (r / height);
+                context->AdvectRow(job, 0, width, y, z, &row[0]);
+                WriteVoxelSpan(dest, 0, y, z, width, (const unsigned char*) &row[0]);
+            }
+        });
+}
+
+} // namespace OpenVOX
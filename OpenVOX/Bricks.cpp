@@ -0,0 +1,181 @@
+#include "Common.hpp"
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <mutex>
+
+namespace OpenVOX {
+
+// Sparse volumes are made of 8^3 bricks behind a two-level index.  The top level has one
+// slot per 64^3 region of the volume and points at a table of 512 brick pointers, so that
+// untouched space costs a single null pointer per region.  Bricks are carved out of large
+// pages and are only ever released all at once.
+
+static const int RegionShift = 3;   // bricks per region along each axis, log2
+static const int RegionBricks = 1 << (3 * RegionShift);
+static const size_t PageSize = 1 << 20;
+
+struct BrickTable {
+    std::atomic<unsigned char*> Bricks[RegionBricks];
+};
+
+struct BrickIndex {
+    int Regions[3];
+    std::atomic<BrickTable*>* Top;
+    std::mutex Mutex;
+    std::vector<unsigned char*> Pages;
+    std::vector<BrickTable*> Tables;
+    size_t PageUsed;
+    size_t BrickBytes;
+    size_t BrickCount;
+    VOXuint Background;
+};
+
+static inline size_t RegionSlot(const BrickIndex* index, int bx, int by, int bz)
+{
+    return (bx >> RegionShift) + index->Regions[0] * ((by >> RegionShift) + (size_t) index->Regions[1] * (bz >> RegionShift));
+}
+
+static inline int BrickSlot(int bx, int by, int bz)
+{
+    const int mask = (1 << RegionShift) - 1;
+    return (bx & mask) | (by & mask) << RegionShift | (bz & mask) << (2 * RegionShift);
+}
+
+BrickIndex* CreateBrickIndex(const VolumePod* volume)
+{
+    BrickIndex* index = new BrickIndex;
+    index->Regions[0] = (BrickCount(volume->Width) + (1 << RegionShift) - 1) >> RegionShift;
+    index->Regions[1] = (BrickCount(volume->Height) + (1 << RegionShift) - 1) >> RegionShift;
+    index->Regions[2] = (BrickCount(volume->Depth) + (1 << RegionShift) - 1) >> RegionShift;
+
+    size_t regionCount = (size_t) index->Regions[0] * index->Regions[1] * index->Regions[2];
+    index->Top = new std::atomic<BrickTable*>[regionCount];
+    for (size_t i = 0; i < regionCount; ++i)
+        index->Top[i].store(0, std::memory_order_relaxed);
+
+    index->PageUsed = PageSize;
+    index->BrickBytes = BrickVoxels * volume->BytesPerVoxel;
+    index->BrickCount = 0;
+    index->Background = 0;
+    return index;
+}
+
+static void ReleaseBricks(BrickIndex* index)
+{
+    for (size_t i = 0; i < index->Pages.size(); ++i)
+        free(index->Pages[i]);
+    for (size_t i = 0; i < index->Tables.size(); ++i)
+        delete index->Tables[i];
+    index->Pages.clear();
+    index->Tables.clear();
+    index->PageUsed = PageSize;
+    index->BrickCount = 0;
+}
+
+void DestroyBrickIndex(BrickIndex* index)
+{
+    ReleaseBricks(index);
+    delete[] index->Top;
+    delete index;
+}
+
+// Drops every brick; the whole volume then reads as the given value.
+void ClearBricks(VolumePod* volume, VOXuint background)
+{
+    BrickIndex* index = volume->Bricks;
+    size_t regionCount = (size_t) index->Regions[0] * index->Regions[1] * index->Regions[2];
+    for (size_t i = 0; i < regionCount; ++i)
+        index->Top[i].store(0, std::memory_order_relaxed);
+    ReleaseBricks(index);
+    index->Background = background;
+}
+
+VOXuint GetBackground(const VolumePod* volume)
+{
+    return volume->Bricks->Background;
+}
+
+size_t GetBrickCount(const VolumePod* volume)
+{
+    return volume->Bricks->BrickCount;
+}
+
+unsigned char* FindBrick(const VolumePod* volume, int bx, int by, int bz)
+{
+    const BrickIndex* index = volume->Bricks;
+    BrickTable* table = index->Top[RegionSlot(index, bx, by, bz)].load(std::memory_order_acquire);
+    return table ? table->Bricks[BrickSlot(bx, by, bz)].load(std::memory_order_acquire) : 0;
+}
+
+// Returns the brick, allocating it (filled with the background value) if this is the first
+// write to it, or null if that allocation fails.  Safe to call from several threads at
+// once; only first touches take the lock.
+unsigned char* TouchBrick(VolumePod* volume, int bx, int by, int bz)
+{
+    BrickIndex* index = volume->Bricks;
+    std::atomic<BrickTable*>& top = index->Top[RegionSlot(index, bx, by, bz)];
+    BrickTable* table = top.load(std::memory_order_acquire);
+    if (table) {
+        unsigned char* brick = table->Bricks[BrickSlot(bx, by, bz)].load(std::memory_order_acquire);
+        if (brick)
+            return brick;
+    }
+
+    std::lock_guard<std::mutex> lock(index->Mutex);
+
+    table = top.load(std::memory_order_relaxed);
+    if (!table) {
+        table = new BrickTable;
+        for (int i = 0; i < RegionBricks; ++i)
+            table->Bricks[i].store(0, std::memory_order_relaxed);
+        index->Tables.push_back(table);
+        top.store(table, std::memory_order_release);
+    }
+
+    std::atomic<unsigned char*>& slot = table->Bricks[BrickSlot(bx, by, bz)];
+    unsigned char* brick = slot.load(std::memory_order_relaxed);
+    if (brick)
+        return brick;
+
+    if (index->PageUsed + index->BrickBytes > PageSize) {
+        unsigned char* page = (unsigned char*) malloc(PageSize);
+        if (!page) {
+            ReportError(volume->Context, "Unable to allocate sparse volume bricks.\n");
+            return 0;
+        }
+        index->Pages.push_back(page);
+        index->PageUsed = 0;
+    }
+    brick = index->Pages.back() + index->PageUsed;
+    index->PageUsed += index->BrickBytes;
+    index->BrickCount++;
+
+    FillVoxels(brick, BrickVoxels, volume->BytesPerVoxel, index->Background);
+    slot.store(brick, std::memory_order_release);
+    return brick;
+}
+
+void ForEachBrick(const VolumePod* volume, const std::function<void(int bx, int by, int bz, const unsigned char* brick)>& fn)
+{
+    const BrickIndex* index = volume->Bricks;
+    for (int rz = 0; rz < index->Regions[2]; ++rz)
+    for (int ry = 0; ry < index->Regions[1]; ++ry)
+    for (int rx = 0; rx < index->Regions[0]; ++rx) {
+        BrickTable* table = index->Top[rx + index->Regions[0] * (ry + (size_t) index->Regions[1] * rz)].load(std::memory_order_acquire);
+        if (!table)
+            continue;
+        for (int i = 0; i < RegionBricks; ++i) {
+            const unsigned char* brick = table->Bricks[i].load(std::memory_order_acquire);
+            if (!brick)
+                continue;
+            const int mask = (1 << RegionShift) - 1;
+            fn(rx << RegionShift | (i & mask),
+               ry << RegionShift | ((i >> RegionShift) & mask),
+               rz << RegionShift | (i >> (2 * RegionShift)),
+               brick);
+        }
+    }
+}
+
+} // namespace OpenVOX
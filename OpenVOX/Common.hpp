@@ -0,0 +1,344 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include <stddef.h>
+#include <openvox.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Everything behind the C API lives in this namespace, so that its types can't collide
+// with those of the application that links the library.
+namespace OpenVOX {
+
+#ifdef _MSC_VER
+inline int LowestBit(unsigned long long v) { unsigned long i; _BitScanForward64(&i, v); return (int) i; }
+inline int BitCount(unsigned long long v) { return (int) __popcnt64(v); }
+inline void AtomicOr(unsigned long long* p, unsigned long long v) { _InterlockedOr64((volatile long long*) p, (long long) v); }
+#else
+inline int LowestBit(unsigned long long v) { return __builtin_ctzll(v); }
+inline int BitCount(unsigned long long v) { return __builtin_popcountll(v); }
+inline void AtomicOr(unsigned long long* p, unsigned long long v) { __atomic_fetch_or(p, v, __ATOMIC_RELAXED); }
+#endif
+
+enum HandleKind {
+    HandleContext = 0x564f5801,
+    HandleMesh,
+    HandleVolume,
+};
+
+struct ThreadPool;
+struct GridPod;
+struct BrickIndex;
+struct VoxelHash;
+struct OctreePod;
+
+// Sparse volumes are tiled into bricks of BrickSize^3 voxels.
+const int BrickShift = 3;
+const int BrickSize = 1 << BrickShift;
+const int BrickVoxels = BrickSize * BrickSize * BrickSize;
+inline int BrickCount(VOXuint extent) { return (int) ((extent + BrickSize - 1) >> BrickShift); }
+
+// Hash and octree volumes pack a voxel's coordinates into one 64-bit key, KeyAxisBits per axis.
+const int KeyAxisBits = 21;
+
+// VOX_TYPE_BIT rows are padded to whole 64-bit words.
+inline size_t BitRowWords(VOXuint width) { return (width + 63) / 64; }
+
+// A triangle in grid-offset space, ready for the triangle/box overlap tests.
+struct TrianglePod {
+    float V[3][3];  // vertices
+    float E[3][3];  // edges
+    float FE[3][3]; // absolute values of the edges
+    float N[3];     // plane normal, and the range of the vertices' distances along it
+    float DMin;
+    float DMax;
+    int Min[3];     // clamped voxel-space bounding box
+    int Max[3];
+};
+
+// Tests up to 64 consecutive voxels of the row (y, z) starting at x; bit i of the result is voxel x + i.
+typedef unsigned long long (*RowTestFunc)(const TrianglePod& tri, const GridPod& grid, int x, int count, int y, int z);
+
+// A float volume as plain memory: voxel (x, y, z) starts at Base + (x + y * Row + z * Slice)
+// * Components.  Slice is negative for the flipped dense volumes.
+struct FieldView {
+    const float* Base;
+    ptrdiff_t Row;
+    ptrdiff_t Slice;
+    int Components;
+};
+
+// One semi-Lagrangian step: every voxel takes the value of Source a time step back along
+// Velocity.  Fluid, when not null, is 1 in fluid voxels and 0 in obstacles, and is laid out
+// like Source in voxels.
+struct AdvectPod {
+    FieldView Source;
+    FieldView Velocity;
+    const float* Fluid;
+    int Extent[3];
+    float TimeStep;
+};
+
+// Advects count voxels of the row (y, z) starting at x into dest, Components floats each.
+typedef void (*AdvectRowFunc)(const AdvectPod& job, int x, int count, int y, int z, float* dest);
+
+struct ObjectPod {
+    HandleKind Kind;
+    struct ContextPod* Context;
+};
+
+struct ContextPod : ObjectPod {
+    void (*ErrorCallback)(const char *, void *);
+    void* UserData;
+    ThreadPool* Pool;
+    RowTestFunc TestRow;
+    AdvectRowFunc AdvectRow;
+    std::vector<TrianglePod> Triangles; // voxelizer scratch, reused between calls
+    std::vector<size_t> JobOffsets;
+    std::vector<float> Field;           // distance transform scratch, likewise
+    std::vector<float> Fluid;           // advection scratch: fluid fractions, and copies of
+    std::vector<float> Velocity;        // volumes that are not dense and linear
+    std::vector<float> Quantity;
+};
+
+struct MeshPod : ObjectPod {
+    GLuint VertexBuffer;
+    GLuint IndexBuffer;
+    VOXuint VertStride;
+    VOXenum IndexType;
+    VOXuint VertexCount;
+    VOXuint TriangleCount;
+    std::vector<float> Positions; // packed xyz
+    std::vector<VOXuint> Indices; // three per triangle
+    float MinCorner[3];
+    float MaxCorner[3];
+    unsigned int Revision;                // bumped whenever the vertices change
+    std::vector<struct VolumePod*> Targets; // volumes that voxelize this mesh incrementally
+};
+
+// Maps world space onto the voxel lattice the same way RunOpenCL does:
+// voxel i along an axis is centered at i * Delta - Offset.
+struct GridPod {
+    float Scale[3];
+    float Offset[3];
+    float Delta[3];
+    float HalfSize[3];
+    int Extent[3];
+};
+
+// A mesh that has been voxelized into a volume in incremental mode, with the grid and the
+// vertex positions that the volume's contents currently reflect.
+struct SourcePod {
+    MeshPod* Mesh;
+    GridPod Grid;
+    unsigned int Revision;
+    std::vector<float> Positions;
+    std::vector<VOXuint> Dirty; // scratch: the triangles that reach the bricks being redone
+};
+
+// One flag per BrickSize^3 brick of a volume.
+struct BrickMask {
+    int Count[3];
+    std::vector<unsigned char> Flags;
+    bool Test(int bx, int by, int bz) const { return Flags[bx + Count[0] * (by + (size_t) Count[1] * bz)] != 0; }
+};
+
+struct VolumePod : ObjectPod {
+    VOXuint Width;
+    VOXuint Height;
+    VOXuint Depth;
+    VOXenum Type;
+    VOXuint BytesPerVoxel;    // zero for VOX_TYPE_BIT
+    size_t RowPitch;          // linear pitches, also used by linear imports and exports
+    size_t SlicePitch;
+    size_t ByteCount;
+    VOXenum Layout;           // dense storage: VOX_LAYOUT_LINEAR or VOX_LAYOUT_TILED
+    unsigned char* Data;      // dense storage
+    bool OwnsData;
+    VOXenum Storage;
+    BrickIndex* Bricks;       // sparse storage
+    VoxelHash* Hash;          // hash storage; set voxels read as all ones
+    OctreePod* Octree;        // octree storage, likewise
+    VOXuint FillValue;        // value of the last fill, restored when bricks are redone
+    std::vector<SourcePod> Sources;
+};
+
+struct ParamBlock {
+    VOXuint ClearValue;
+    VOXbool VoxelizeBoundsEnable;
+    VOXfloat VoxelizeBounds[6];
+    VOXuint ThreadCount;
+    VOXuint SimdWidth;
+    VOXbool PlaneSpans;
+    VOXenum VolumeStorage;
+    VOXbool Incremental;
+    VOXenum VolumeLayout;
+    VOXfloat ReferenceMargin;
+    VOXfloat NarrowBand;
+    VOXhandle SignVolume;
+    VOXhandle FluidObstacles;
+    VOXhandle FluidVelocity;
+    VOXfloat FluidTimeStep;
+};
+
+// Sources are a kind (CL buffer, GL texture, CPU memory...) combined with a pointer mode.
+inline VOXenum SourceKind(VOXenum flags) { return (VOXenum) (flags & 0xf00f); }
+inline VOXenum SourceMode(VOXenum flags) { return (VOXenum) (flags & 0x0ff0); }
+
+template<class T> T* CastHandle(VOXhandle handle, HandleKind kind)
+{
+    ObjectPod* pod = (ObjectPod*) handle;
+    return (pod && pod->Kind == kind) ? (T*) pod : 0;
+}
+
+// Spreads the low three bits of v to bits 0, 3 and 6.
+inline unsigned SpreadTileBits(unsigned v) { return (v & 1) | (v & 2) << 2 | (v & 4) << 4; }
+
+// Linear volumes are stored with slices flipped along Z, matching the OpenCL voxelizer and
+// the raycasting shaders that sample its output.  Tiled volumes are made of BrickSize^3
+// tiles whose voxels are in Z-order, so that all six neighbours of most voxels are within
+// a few cache lines; they are not flipped, since no shader samples them directly.
+inline size_t VoxelOffset(const VolumePod* volume, int x, int y, int z)
+{
+    if (volume->Layout == VOX_LAYOUT_TILED) {
+        const int mask = BrickSize - 1;
+        size_t tile = (x >> BrickShift) + BrickCount(volume->Width) * ((y >> BrickShift) + (size_t) BrickCount(volume->Height) * (z >> BrickShift));
+        unsigned inner = SpreadTileBits(x & mask) | SpreadTileBits(y & mask) << 1 | SpreadTileBits(z & mask) << 2;
+        return ((tile << (3 * BrickShift)) + inner) * volume->BytesPerVoxel;
+    }
+    return x * volume->BytesPerVoxel + y * volume->RowPitch + (volume->Depth - 1 - z) * volume->SlicePitch;
+}
+
+// Bricks are small enough to stay in cache, so their voxels are simply x-fastest.
+inline size_t BrickVoxelOffset(const VolumePod* volume, int x, int y, int z)
+{
+    const int mask = BrickSize - 1;
+    return ((x & mask) + BrickSize * ((y & mask) + BrickSize * (z & mask))) * volume->BytesPerVoxel;
+}
+
+unsigned char* TouchBrick(VolumePod* volume, int bx, int by, int bz);
+
+// Address of a voxel that is about to be written, allocating its brick if need be; null
+// if the brick could not be allocated.
+inline unsigned char* TouchVoxel(VolumePod* volume, int x, int y, int z)
+{
+    if (volume->Bricks) {
+        unsigned char* brick = TouchBrick(volume, x >> BrickShift, y >> BrickShift, z >> BrickShift);
+        return brick ? brick + BrickVoxelOffset(volume, x, y, z) : 0;
+    }
+    return volume->Data + VoxelOffset(volume, x, y, z);
+}
+
+// Context.cpp
+void ReportError(ContextPod* context, const char* pStr, ...);
+
+// Params.cpp
+const ParamBlock& GetParams();
+void ForgetParamHandle(VOXhandle handle);
+
+// Threads.cpp
+ThreadPool* CreateThreadPool(unsigned int threadCount);
+void DestroyThreadPool(ThreadPool* pool);
+unsigned int GetThreadCount(ThreadPool* pool);
+void ParallelFor(ThreadPool* pool, size_t count, size_t grain,
+                 const std::function<void(size_t begin, size_t end, unsigned int thread)>& body);
+
+// Mesh.cpp
+void DeleteMesh(MeshPod* mesh);
+bool RefreshMesh(MeshPod* mesh);
+
+// Volume.cpp
+void DeleteVolume(VolumePod* volume);
+VOXuint GetBytesPerVoxel(VOXenum type);
+void FillVolume(VolumePod* volume, VOXuint value);
+void FillVoxels(unsigned char* dest, size_t count, VOXuint bytesPerVoxel, VOXuint value);
+void ReadVoxelSpan(const VolumePod* volume, int x, int y, int z, int count, unsigned char* dest);
+void WriteVoxelSpan(VolumePod* volume, int x, int y, int z, int count, const unsigned char* src);
+void FillBrick(VolumePod* volume, int bx, int by, int bz, VOXuint value);
+
+// Advect.cpp
+void TransformAdvect(VolumePod* dest, const VolumePod* src);
+void AdvectRowScalar(const AdvectPod& job, int x, int count, int y, int z, float* dest);
+AdvectRowFunc ChooseAdvectRow(VOXuint simdWidth);
+
+// Advect.avx2.cpp
+void AdvectRowAvx2(const AdvectPod& job, int x, int count, int y, int z, float* dest);
+
+// Bricks.cpp
+BrickIndex* CreateBrickIndex(const VolumePod* volume);
+void DestroyBrickIndex(BrickIndex* index);
+void ClearBricks(VolumePod* volume, VOXuint background);
+VOXuint GetBackground(const VolumePod* volume);
+size_t GetBrickCount(const VolumePod* volume);
+unsigned char* FindBrick(const VolumePod* volume, int bx, int by, int bz);
+void ForEachBrick(const VolumePod* volume, const std::function<void(int bx, int by, int bz, const unsigned char* brick)>& fn);
+
+// Distance.cpp
+void TransformDistance(VolumePod* dest, const VolumePod* src, VOXenum op);
+
+// Hash.cpp
+VoxelHash* CreateVoxelHash();
+void DestroyVoxelHash(VoxelHash* hash);
+void ClearVoxelHash(VoxelHash* hash);
+size_t GetVoxelHashCount(const VoxelHash* hash);
+bool InsertVoxel(VoxelHash* hash, int x, int y, int z);
+bool FindVoxel(const VoxelHash* hash, int x, int y, int z);
+void RemoveVoxel(VoxelHash* hash, int x, int y, int z);
+void ForEachVoxel(const VoxelHash* hash, const std::function<void(int x, int y, int z)>& fn);
+void ReserveVoxelHash(VoxelHash* hash, size_t count);
+void RepeatOnOverflow(VolumePod* volume, const std::function<void()>& pass);
+
+// NarrowBand.cpp
+void TransformNarrowBand(VolumePod* dest, const VolumePod* src);
+
+// Octree.cpp
+OctreePod* CreateOctree(const VolumePod* volume);
+void DestroyOctree(OctreePod* octree);
+void ClearOctree(OctreePod* octree);
+size_t GetOctreeCount(const OctreePod* octree);
+bool FindOctreeVoxel(const OctreePod* octree, int x, int y, int z);
+void ForEachOctreeVoxel(const OctreePod* octree, const std::function<void(int x, int y, int z)>& fn);
+void AppendOctreeVoxels(OctreePod* octree, int x, int y, int z, unsigned long long mask);
+void VoxelizeOctree(MeshPod* mesh, VolumePod* volume, const GridPod& grid);
+
+// Voxelize.cpp
+GridPod CreateGrid(const VolumePod* volume, const float minCorner[3], const float maxCorner[3]);
+void QuantizeBounds(const float* v0, const float* v1, const float* v2, const GridPod& grid, int minCorner[3], int maxCorner[3]);
+bool SetupTriangle(const MeshPod* mesh, VOXuint triangle, const GridPod& grid, TrianglePod& tri);
+void CullTriangles(const MeshPod* mesh, const GridPod& grid, const BrickMask& dirty, std::vector<VOXuint>& triangles);
+void VoxelizeSurface(MeshPod* mesh, VolumePod* volume, const GridPod& grid, const BrickMask* dirty, const std::vector<VOXuint>* subset);
+bool TestRowAxisX(const TrianglePod& tri, const GridPod& grid, int y, int z);
+unsigned long long TestRowScalar(const TrianglePod& tri, const GridPod& grid, int x, int count, int y, int z);
+void WriteRow(VolumePod* volume, int x, int y, int z, unsigned long long mask);
+size_t EstimateSurfaceVoxels(const MeshPod* mesh, const GridPod& grid);
+
+// Reference.cpp
+void VoxelizeReference(MeshPod* mesh, VolumePod* volume, const float minCorner[3], const float maxCorner[3]);
+
+// Stencil.cpp
+void TransformStencil(VolumePod* dest, const VolumePod* src, VOXenum op);
+
+// Thin.cpp
+void VoxelizeThin(MeshPod* mesh, VolumePod* volume, const GridPod& grid);
+
+// Volumetric.cpp
+void VoxelizeVolumetric(MeshPod* mesh, VolumePod* volume, const GridPod& grid);
+
+// Incremental.cpp
+void VoxelizeIncremental(MeshPod* mesh, VolumePod* volume, const GridPod& grid);
+void DetachSources(VolumePod* volume);
+void DetachTargets(MeshPod* mesh);
+
+// RowTest.cpp
+bool CpuSupports(int simdWidth);
+RowTestFunc ChooseRowTest(VOXuint simdWidth);
+
+// RowTest.avx2.cpp
+unsigned long long TestRowAvx2(const TrianglePod& tri, const GridPod& grid, int x, int count, int y, int z);
+
+// RowTest.avx512.cpp
+unsigned long long TestRowAvx512(const TrianglePod& tri, const GridPod& grid, int x, int count, int y, int z);
+
+} // namespace OpenVOX
@@ -0,0 +1,60 @@
+#include "Common.hpp"
+#include <stdio.h>
+#include <stdarg.h>
+
+using namespace OpenVOX;
+
+VOXhandle voxCreateContext(
+    void (*error_callback)(const char *, void *),
+    void *user_data)
+{
+    ContextPod* context = new ContextPod;
+    context->Kind = HandleContext;
+    context->Context = context;
+    context->ErrorCallback = error_callback;
+    context->UserData = user_data;
+    context->Pool = CreateThreadPool(GetParams().ThreadCount);
+    context->TestRow = ChooseRowTest(GetParams().SimdWidth);
+    context->AdvectRow = ChooseAdvectRow(GetParams().SimdWidth);
+    return context;
+}
+
+void voxDeleteHandle(VOXhandle handle)
+{
+    ObjectPod* pod = (ObjectPod*) handle;
+    if (!pod)
+        return;
+
+    switch (pod->Kind)
+    {
+        case HandleContext:
+        {
+            ContextPod* context = (ContextPod*) pod;
+            DestroyThreadPool(context->Pool);
+            delete context;
+            break;
+        }
+        case HandleMesh:   DeleteMesh((MeshPod*) pod); break;
+        case HandleVolume: DeleteVolume((VolumePod*) pod); break;
+        default: ReportError(0, "voxDeleteHandle: unknown handle %p\n", handle);
+    }
+}
+
+namespace OpenVOX {
+
+void ReportError(ContextPod* context, const char* pStr, ...)
+{
+    va_list a;
+    va_start(a, pStr);
+
+    char msg[1024] = {0};
+    vsnprintf(msg, sizeof(msg), pStr, a);
+    va_end(a);
+
+    if (context && context->ErrorCallback)
+        context->ErrorCallback(msg, context->UserData);
+    else
+        fputs(msg, stderr);
+}
+
+} // namespace OpenVOX
@@ -0,0 +1,194 @@
+#include "Common.hpp"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+namespace OpenVOX {
+
+// Exact distance transforms.  Every voxel gets its distance, in voxels, to the nearest
+// non-zero voxel of the source, one axis at a time: the 1D distances along x, then along y
+// the lower envelope of the parabolas (y - q)^2 + f(q) over those, then the same along z
+// [Felzenszwalb & Huttenlocher, "Distance Transforms of Sampled Functions"].  Each pass is
+// linear in the number of voxels.  The Manhattan metric is separable the same way, with
+// cones |y - q| + f(q) in place of the parabolas, which two scans take care of.
+//
+// The passes work on a float copy of the volume, x-fastest and not flipped.  The y and z
+// passes would stride a row or a slice between consecutive samples, so instead they gather
+// DistanceBlock neighbouring columns at once, one cache line per row or slice, run them
+// side by side, and scatter them back.  Squared distances are whole numbers, exact in a
+// float for distances up to 4096 voxels.
+
+static const int DistanceBlock = 16; // floats per 64-byte cache line
+static const float Infinity = HUGE_VALF;
+
+struct EnvelopePod {
+    std::vector<float> F;   // the column being transformed
+    std::vector<int> V;     // samples whose parabolas form the lower envelope
+    std::vector<double> Z;  // where each of them takes over
+};
+
+// 1D distances to the nearest feature of a row, squared or not.
+static void RowDistance(const unsigned char* row, int n, int bytesPerVoxel, bool squared, float* dest)
+{
+    static const unsigned char zero[16] = { 0 };
+    int last = -1;
+    for (int x = 0; x < n; ++x) {
+        if (memcmp(row + x * bytesPerVoxel, zero, bytesPerVoxel))
+            last = x;
+        dest[x] = last < 0 ? Infinity : (float) (x - last);
+    }
+    last = -1;
+    for (int x = n - 1; x >= 0; --x) {
+        if (dest[x] == 0)
+            last = x;
+        if (last >= 0 && last - x < dest[x])
+            dest[x] = (float) (last - x);
+        if (squared && dest[x] != Infinity)
+            dest[x] *= dest[x];
+    }
+}
+
+// Replaces f(t) with min over q of (t - q)^2 + f(q).  Infinite samples have no parabola.
+static void SquaredDistance1D(float* column, int n, int stride, EnvelopePod& e)
+{
+    int k = -1;
+    for (int q = 0; q < n; ++q) {
+        float fq = e.F[q] = column[q * stride];
+        if (fq == Infinity)
+            continue;
+        // The new parabola undercuts the last one from where they cross; if that is before
+        // the last one takes over, the last one is hidden.  Only survivors pay for a division.
+        double start = -HUGE_VAL;
+        while (k >= 0) {
+            int p = e.V[k];
+            double cross = (fq + (double) q * q) - (e.F[p] + (double) p * p);
+            double span = 2.0 * (q - p);
+            if (cross > e.Z[k] * span) {
+                start = cross / span;
+                break;
+            }
+            --k;
+        }
+        e.V[++k] = q;
+        e.Z[k] = start;
+    }
+    if (k < 0)
+        return;
+
+    e.Z[k + 1] = HUGE_VAL;
+    for (int t = 0, j = 0; t < n; ++t) {
+        while (e.Z[j + 1] < t)
+            ++j;
+        int p = e.V[j];
+        column[t * stride] = (float) ((double) (t - p) * (t - p) + e.F[p]);
+    }
+}
+
+// Replaces f(t) with min over q of |t - q| + f(q).
+static void ManhattanDistance1D(float* column, int n, int stride)
+{
+    for (int t = 1; t < n; ++t)
+        column[t * stride] = std::min(column[t * stride], column[(t - 1) * stride] + 1);
+    for (int t = n - 2; t >= 0; --t)
+        column[t * stride] = std::min(column[t * stride], column[(t + 1) * stride] + 1);
+}
+
+// Transforms the columns of one pass, DistanceBlock of them at a time.  Column c of block b
+// starts at base(b) + c and its samples are pitch floats apart.
+static void TransformColumns(ContextPod* context, float* field, int width, size_t blockCount, int n, size_t pitch,
+                             const std::function<size_t(size_t block)>& base, bool manhattan)
+{
+    ParallelFor(context->Pool, blockCount, 1,
+        [&](size_t begin, size_t end, unsigned int) {
+            std::vector<float> gathered((size_t) n * DistanceBlock);
+            EnvelopePod e;
+            e.F.resize(n);
+            e.V.resize(n);
+            e.Z.resize(n + 1);
+            for (size_t b = begin; b < end; ++b) {
+                size_t first = base(b);
+                int x0 = (int) (first % width);
+                int count = std::min(DistanceBlock, width - x0);
+                for (int i = 0; i < n; ++i)
+                    memcpy(&gathered[(size_t) i * DistanceBlock], field + first + i * pitch, count * sizeof(float));
+                for (int c = 0; c < count; ++c) {
+                    if (manhattan)
+                        ManhattanDistance1D(&gathered[c], n, DistanceBlock);
+                    else
+                        SquaredDistance1D(&gathered[c], n, DistanceBlock, e);
+                }
+                for (int i = 0; i < n; ++i)
+                    memcpy(field + first + i * pitch, &gathered[(size_t) i * DistanceBlock], count * sizeof(float));
+            }
+        });
+}
+
+template<class T> static void ConvertRow(const float* src, int n, float limit, T* dest)
+{
+    for (int x = 0; x < n; ++x)
+        dest[x] = src[x] < limit ? (T) (src[x] + 0.5f) : (T) limit;
+}
+
+void TransformDistance(VolumePod* dest, const VolumePod* src, VOXenum op)
+{
+    if (!dest->Data || dest->Bricks || (dest->Type != VOX_TYPE_FLOAT32 && dest->Type != VOX_TYPE_UINT32 &&
+                                        dest->Type != VOX_TYPE_UINT16 && dest->Type != VOX_TYPE_UINT8)) {
+        ReportError(dest->Context, "voxTransform: distances need a dense VOX_TYPE_FLOAT32 or integer destination.\n");
+        return;
+    }
+
+    ContextPod* context = dest->Context;
+    const int width = src->Width, height = src->Height, depth = src->Depth;
+    const size_t rowCount = (size_t) height * depth;
+    const size_t slicePitch = (size_t) width * height;
+    const bool manhattan = op == VOX_TRANSFORM_DISTANCE_MANHATTAN;
+    std::vector<float>& field = context->Field;
+    field.resize(slicePitch * depth);
+
+    // Along x, straight from the source.
+    ParallelFor(context->Pool, rowCount, 16,
+        [&](size_t begin, size_t end, unsigned int) {
+            const int bytesPerVoxel = src->BytesPerVoxel ? src->BytesPerVoxel : 1;
+            std::vector<unsigned char> row((size_t) width * bytesPerVoxel);
+            for (size_t r = begin; r < end; ++r) {
+                ReadVoxelSpan(src, 0, (int) (r % height), (int) (r / height), width, &row[0]);
+                RowDistance(&row[0], width, bytesPerVoxel, !manhattan, &field[r * width]);
+            }
+        });
+
+    // Along y within each slice, then along z within each row of slices.
+    const size_t blocksPerRow = (width + DistanceBlock - 1) / DistanceBlock;
+    TransformColumns(context, &field[0], width, blocksPerRow * depth, height, width,
+        [&](size_t b) { return (b / blocksPerRow) * slicePitch + (b % blocksPerRow) * DistanceBlock; }, manhattan);
+    TransformColumns(context, &field[0], width, blocksPerRow * height, depth, slicePitch,
+        [&](size_t b) { return (b / blocksPerRow) * width + (b % blocksPerRow) * DistanceBlock; }, manhattan);
+
+    // Integer destinations round and saturate; voxels with nothing to be near stay infinite
+    // in float volumes and saturate in the others.
+    DetachSources(dest);
+    const float limit = dest->Type == VOX_TYPE_UINT8 ? 255.0f : dest->Type == VOX_TYPE_UINT16 ? 65535.0f : 4294967040.0f;
+    ParallelFor(context->Pool, rowCount, 16,
+        [&](size_t begin, size_t end, unsigned int) {
+            std::vector<float> distance(width);
+            std::vector<unsigned char> row((size_t) width * dest->BytesPerVoxel);
+            for (size_t r = begin; r < end; ++r) {
+                const float* f = &field[r * width];
+                if (op == VOX_TRANSFORM_DISTANCE_EUCLIDEAN) {
+                    for (int x = 0; x < width; ++x)
+                        distance[x] = sqrtf(f[x]);
+                    f = &distance[0];
+                }
+                switch (dest->Type)
+                {
+                    case VOX_TYPE_FLOAT32: memcpy(&row[0], f, width * sizeof(float)); break;
+                    case VOX_TYPE_UINT32: ConvertRow(f, width, limit, (VOXuint*) &row[0]); break;
+                    case VOX_TYPE_UINT16: ConvertRow(f, width, limit, (VOXushort*) &row[0]); break;
+                    case VOX_TYPE_UINT8: ConvertRow(f, width, limit, &row[0]); break;
+                    default: break;
+                }
+                WriteVoxelSpan(dest, 0, (int) (r % height), (int) (r / height), width, &row[0]);
+            }
+        });
+}
+
+} // namespace OpenVOX
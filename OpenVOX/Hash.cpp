@@ -0,0 +1,203 @@
+#include "Common.hpp"
+#include <atomic>
+
+namespace OpenVOX {
+
+// Hash volumes keep only the coordinates of their set voxels, in an open-addressing table
+// with linear probing.  Keys are claimed with a single compare-and-swap, so every thread of
+// a voxelization pass can insert at once without locks.  The table never grows during a
+// pass: an insert that would push it past three quarters full is refused and flags the
+// table, and RepeatOnOverflow then rehashes into a larger table and runs the pass again.
+// Every writer stores the same "set" state, so repeating a pass is harmless.
+
+static const VOXuint64 EmptyKey = ~0ull;
+static const VOXuint64 RemovedKey = ~0ull - 1;
+static const size_t MinCapacity = 1 << 16;
+
+struct VoxelHash {
+    std::atomic<VOXuint64>* Keys;
+    size_t Capacity;              // power of two
+    std::atomic<size_t> Used;     // slots that are not empty, including removed ones
+    std::atomic<size_t> Count;    // live keys
+    std::atomic<bool> Overflow;
+};
+
+static inline VOXuint64 PackKey(int x, int y, int z)
+{
+    return (VOXuint64) x | (VOXuint64) y << KeyAxisBits | (VOXuint64) z << (2 * KeyAxisBits);
+}
+
+// The splitmix64 finalizer; packed coordinates are far from uniformly distributed.
+static inline size_t HashKey(VOXuint64 key)
+{
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ull;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebull;
+    return (size_t) (key ^ (key >> 31));
+}
+
+static std::atomic<VOXuint64>* AllocateKeys(size_t capacity)
+{
+    std::atomic<VOXuint64>* keys = new std::atomic<VOXuint64>[capacity];
+    for (size_t i = 0; i < capacity; ++i)
+        keys[i].store(EmptyKey, std::memory_order_relaxed);
+    return keys;
+}
+
+VoxelHash* CreateVoxelHash()
+{
+    VoxelHash* hash = new VoxelHash;
+    hash->Capacity = MinCapacity;
+    hash->Keys = AllocateKeys(hash->Capacity);
+    hash->Used.store(0);
+    hash->Count.store(0);
+    hash->Overflow.store(false);
+    return hash;
+}
+
+void DestroyVoxelHash(VoxelHash* hash)
+{
+    delete[] hash->Keys;
+    delete hash;
+}
+
+void ClearVoxelHash(VoxelHash* hash)
+{
+    for (size_t i = 0; i < hash->Capacity; ++i)
+        hash->Keys[i].store(EmptyKey, std::memory_order_relaxed);
+    hash->Used.store(0);
+    hash->Count.store(0);
+    hash->Overflow.store(false);
+}
+
+size_t GetVoxelHashCount(const VoxelHash* hash)
+{
+    return hash->Count.load();
+}
+
+// Returns false, and flags the table, if the voxel is new and there is no room for it.
+// Once flagged, inserts fail straight away; the pass is going to be repeated anyway.
+bool InsertVoxel(VoxelHash* hash, int x, int y, int z)
+{
+    if (hash->Overflow.load(std::memory_order_relaxed))
+        return false;
+
+    const VOXuint64 key = PackKey(x, y, z);
+    const size_t mask = hash->Capacity - 1;
+    for (size_t i = HashKey(key) & mask;; i = (i + 1) & mask) {
+        VOXuint64 slot = hash->Keys[i].load(std::memory_order_acquire);
+        if (slot == key)
+            return true;
+        if (slot != EmptyKey)
+            continue;
+
+        if (hash->Used.load(std::memory_order_relaxed) >= hash->Capacity - hash->Capacity / 4) {
+            hash->Overflow.store(true, std::memory_order_relaxed);
+            return false;
+        }
+
+        // Losing the race to the same key is as good as winning; to another key, keep probing.
+        if (hash->Keys[i].compare_exchange_strong(slot, key, std::memory_order_acq_rel)) {
+            hash->Used.fetch_add(1, std::memory_order_relaxed);
+            hash->Count.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        if (slot == key)
+            return true;
+    }
+}
+
+bool FindVoxel(const VoxelHash* hash, int x, int y, int z)
+{
+    const VOXuint64 key = PackKey(x, y, z);
+    const size_t mask = hash->Capacity - 1;
+    for (size_t i = HashKey(key) & mask;; i = (i + 1) & mask) {
+        VOXuint64 slot = hash->Keys[i].load(std::memory_order_acquire);
+        if (slot == key)
+            return true;
+        if (slot == EmptyKey)
+            return false;
+    }
+}
+
+// Removed keys leave a marker behind so that probe chains stay intact until the next rehash.
+void RemoveVoxel(VoxelHash* hash, int x, int y, int z)
+{
+    if (!hash->Count.load(std::memory_order_relaxed))
+        return;
+
+    const VOXuint64 key = PackKey(x, y, z);
+    const size_t mask = hash->Capacity - 1;
+    for (size_t i = HashKey(key) & mask;; i = (i + 1) & mask) {
+        VOXuint64 slot = hash->Keys[i].load(std::memory_order_acquire);
+        if (slot == EmptyKey)
+            return;
+        if (slot == key && hash->Keys[i].compare_exchange_strong(slot, RemovedKey, std::memory_order_acq_rel)) {
+            hash->Count.fetch_sub(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+void ForEachVoxel(const VoxelHash* hash, const std::function<void(int x, int y, int z)>& fn)
+{
+    const VOXuint64 axisMask = (1ull << KeyAxisBits) - 1;
+    for (size_t i = 0; i < hash->Capacity; ++i) {
+        VOXuint64 key = hash->Keys[i].load(std::memory_order_acquire);
+        if (key == EmptyKey || key == RemovedKey)
+            continue;
+        fn((int) (key & axisMask), (int) ((key >> KeyAxisBits) & axisMask), (int) (key >> (2 * KeyAxisBits)));
+    }
+}
+
+// Rehashes into a table with room for at least the given number of keys at under half
+// load, dropping removed keys.  Not thread-safe.
+static void Rehash(VoxelHash* hash, size_t room)
+{
+    size_t capacity = MinCapacity;
+    while (capacity < 2 * room)
+        capacity *= 2;
+
+    std::atomic<VOXuint64>* old = hash->Keys;
+    size_t oldCapacity = hash->Capacity;
+    hash->Keys = AllocateKeys(capacity);
+    hash->Capacity = capacity;
+
+    size_t count = 0;
+    const size_t mask = capacity - 1;
+    for (size_t i = 0; i < oldCapacity; ++i) {
+        VOXuint64 key = old[i].load(std::memory_order_relaxed);
+        if (key == EmptyKey || key == RemovedKey)
+            continue;
+        size_t j = HashKey(key) & mask;
+        while (hash->Keys[j].load(std::memory_order_relaxed) != EmptyKey)
+            j = (j + 1) & mask;
+        hash->Keys[j].store(key, std::memory_order_relaxed);
+        ++count;
+    }
+    delete[] old;
+
+    hash->Used.store(count);
+    hash->Count.store(count);
+}
+
+// Makes room for the given number of keys up front, when a pass can tell roughly how many
+// voxels it is about to write, so that it is unlikely to overflow.  Not thread-safe.
+void ReserveVoxelHash(VoxelHash* hash, size_t count)
+{
+    if (hash->Used.load() + count > hash->Capacity / 2)
+        Rehash(hash, hash->Count.load() + count);
+}
+
+// Runs a pass that writes into the volume, then, for as long as a hash volume ran out of
+// room during it, grows the table and runs the pass again.
+void RepeatOnOverflow(VolumePod* volume, const std::function<void()>& pass)
+{
+    pass();
+    while (volume->Hash && volume->Hash->Overflow.load()) {
+        volume->Hash->Overflow.store(false);
+        Rehash(volume->Hash, 2 * volume->Hash->Count.load());
+        pass();
+    }
+}
+
+} // namespace OpenVOX
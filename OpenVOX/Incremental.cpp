@@ -0,0 +1,223 @@
+#include "Common.hpp"
+#include <string.h>
+#include <algorithm>
+
+namespace OpenVOX {
+
+// Incremental voxelization.  A volume remembers every mesh that was voxelized into it
+// since its contents were last replaced, along with the grid and the vertex positions it
+// used.  When one of those meshes changes, only the bricks under its moved triangles (at
+// both their old and new positions) are cleared, and the triangles of every source mesh
+// that reach them are re-voxelized into just those bricks.  Index buffers are assumed not
+// to change.
+
+// Past this fraction of the sources' triangles, a partial pass costs more than clearing
+// the volume and voxelizing everything without the mask.
+static const double FullPassFraction = 0.5;
+
+static SourcePod* FindSource(VolumePod* volume, MeshPod* mesh)
+{
+    for (size_t i = 0; i < volume->Sources.size(); ++i)
+        if (volume->Sources[i].Mesh == mesh)
+            return &volume->Sources[i];
+    return 0;
+}
+
+static bool SameGrid(const GridPod& a, const GridPod& b)
+{
+    return !memcmp(a.Scale, b.Scale, sizeof(a.Scale)) && !memcmp(a.Offset, b.Offset, sizeof(a.Offset)) &&
+           !memcmp(a.Extent, b.Extent, sizeof(a.Extent));
+}
+
+static void MarkBricks(BrickMask& mask, const int lo[3], const int hi[3])
+{
+    for (int bz = lo[2] >> BrickShift; bz <= hi[2] >> BrickShift; ++bz)
+        for (int by = lo[1] >> BrickShift; by <= hi[1] >> BrickShift; ++by)
+            for (int bx = lo[0] >> BrickShift; bx <= hi[0] >> BrickShift; ++bx)
+                mask.Flags[bx + mask.Count[0] * (by + (size_t) mask.Count[1] * bz)] = 1;
+}
+
+// Flags the bricks under every triangle that has a vertex whose position differs from the
+// snapshot, at both the snapshot position and the current one.  Returns the number of
+// moved triangles; without a mask, only counts them.
+static size_t MarkMovedTriangles(const SourcePod& source, BrickMask* mask)
+{
+    const MeshPod* mesh = source.Mesh;
+    const float* now = &mesh->Positions[0];
+    const float* then = &source.Positions[0];
+
+    std::vector<unsigned char> moved(mesh->VertexCount);
+    for (VOXuint v = 0; v < mesh->VertexCount; ++v)
+        moved[v] = memcmp(now + v * 3, then + v * 3, 3 * sizeof(float)) != 0;
+
+    size_t count = 0;
+    for (VOXuint t = 0; t < mesh->TriangleCount; ++t) {
+        const VOXuint* i = &mesh->Indices[t * 3];
+        if (i[0] >= mesh->VertexCount || i[1] >= mesh->VertexCount || i[2] >= mesh->VertexCount)
+            continue;
+        if (!moved[i[0]] && !moved[i[1]] && !moved[i[2]])
+            continue;
+
+        ++count;
+        if (!mask)
+            continue;
+
+        int lo[3], hi[3];
+        QuantizeBounds(then + i[0] * 3, then + i[1] * 3, then + i[2] * 3, source.Grid, lo, hi);
+        MarkBricks(*mask, lo, hi);
+        QuantizeBounds(now + i[0] * 3, now + i[1] * 3, now + i[2] * 3, source.Grid, lo, hi);
+        MarkBricks(*mask, lo, hi);
+    }
+    return count;
+}
+
+// Flags the bricks under every triangle at its snapshot position.
+static void MarkSnapshot(const SourcePod& source, BrickMask& mask)
+{
+    const MeshPod* mesh = source.Mesh;
+    const float* then = source.Positions.empty() ? 0 : &source.Positions[0];
+    VOXuint vertexCount = (VOXuint) (source.Positions.size() / 3);
+    for (VOXuint t = 0; t < mesh->TriangleCount; ++t) {
+        const VOXuint* i = &mesh->Indices[t * 3];
+        if (i[0] >= vertexCount || i[1] >= vertexCount || i[2] >= vertexCount)
+            continue;
+        int lo[3], hi[3];
+        QuantizeBounds(then + i[0] * 3, then + i[1] * 3, then + i[2] * 3, source.Grid, lo, hi);
+        MarkBricks(mask, lo, hi);
+    }
+}
+
+static void CreateMask(const VolumePod* volume, BrickMask& mask)
+{
+    mask.Count[0] = BrickCount(volume->Width);
+    mask.Count[1] = BrickCount(volume->Height);
+    mask.Count[2] = BrickCount(volume->Depth);
+    mask.Flags.assign((size_t) mask.Count[0] * mask.Count[1] * mask.Count[2], 0);
+}
+
+static void Snapshot(SourcePod& source)
+{
+    source.Revision = source.Mesh->Revision;
+    source.Positions = source.Mesh->Positions;
+}
+
+static void Rebuild(VolumePod* volume)
+{
+    FillVolume(volume, volume->FillValue);
+    for (size_t i = 0; i < volume->Sources.size(); ++i) {
+        Snapshot(volume->Sources[i]);
+        VoxelizeSurface(volume->Sources[i].Mesh, volume, volume->Sources[i].Grid, 0, 0);
+    }
+}
+
+// Clears the flagged bricks and voxelizes the sources' triangles that reach them again.
+static void RedoBricks(VolumePod* volume, const BrickMask& dirty)
+{
+    size_t redone = 0, total = 0;
+    for (size_t i = 0; i < volume->Sources.size(); ++i) {
+        SourcePod& s = volume->Sources[i];
+        CullTriangles(s.Mesh, s.Grid, dirty, s.Dirty);
+        redone += s.Dirty.size();
+        total += s.Mesh->TriangleCount;
+    }
+    if (redone > FullPassFraction * total) {
+        Rebuild(volume);
+        return;
+    }
+
+    for (int bz = 0; bz < dirty.Count[2]; ++bz)
+        for (int by = 0; by < dirty.Count[1]; ++by)
+            for (int bx = 0; bx < dirty.Count[0]; ++bx)
+                if (dirty.Test(bx, by, bz))
+                    FillBrick(volume, bx, by, bz, volume->FillValue);
+
+    for (size_t i = 0; i < volume->Sources.size(); ++i)
+        VoxelizeSurface(volume->Sources[i].Mesh, volume, volume->Sources[i].Grid, &dirty, &volume->Sources[i].Dirty);
+}
+
+void VoxelizeIncremental(MeshPod* mesh, VolumePod* volume, const GridPod& grid)
+{
+    SourcePod* source = FindSource(volume, mesh);
+
+    // First time this mesh lands in the volume: voxelize it on top of what is there.
+    if (!source) {
+        volume->Sources.push_back(SourcePod());
+        source = &volume->Sources.back();
+        source->Mesh = mesh;
+        source->Grid = grid;
+        Snapshot(*source);
+        mesh->Targets.push_back(volume);
+        VoxelizeSurface(mesh, volume, grid, 0, 0);
+        return;
+    }
+
+    if (source->Revision == mesh->Revision && SameGrid(source->Grid, grid))
+        return;
+
+    // A new grid leaves nothing to diff against, so rebuild.
+    if (!SameGrid(source->Grid, grid)) {
+        source->Grid = grid;
+        Rebuild(volume);
+        return;
+    }
+
+    // Every source that changed since its snapshot is taken care of in this pass, so that
+    // the other meshes that moved this frame find nothing left to do when their turn comes.
+    // A different vertex count leaves nothing to diff against.
+    size_t moved = 0, total = 0;
+    for (size_t i = 0; i < volume->Sources.size(); ++i) {
+        SourcePod& s = volume->Sources[i];
+        total += s.Mesh->TriangleCount;
+        if (s.Revision == s.Mesh->Revision)
+            continue;
+        if (s.Positions.size() != s.Mesh->Positions.size()) {
+            Rebuild(volume);
+            return;
+        }
+        moved += MarkMovedTriangles(s, 0);
+    }
+    if (moved > FullPassFraction * total) {
+        Rebuild(volume);
+        return;
+    }
+
+    BrickMask dirty;
+    CreateMask(volume, dirty);
+    for (size_t i = 0; i < volume->Sources.size(); ++i) {
+        SourcePod& s = volume->Sources[i];
+        if (s.Revision == s.Mesh->Revision)
+            continue;
+        MarkMovedTriangles(s, moved ? &dirty : 0);
+        Snapshot(s);
+    }
+    if (moved)
+        RedoBricks(volume, dirty);
+}
+
+// Called when a volume's contents are replaced wholesale or it is deleted.
+void DetachSources(VolumePod* volume)
+{
+    for (size_t i = 0; i < volume->Sources.size(); ++i) {
+        std::vector<VolumePod*>& targets = volume->Sources[i].Mesh->Targets;
+        targets.erase(std::remove(targets.begin(), targets.end(), volume), targets.end());
+    }
+    volume->Sources.clear();
+}
+
+// Called when a mesh is deleted.  The bricks under its voxels are cleared, and the other
+// sources are voxelized into them again.
+void DetachTargets(MeshPod* mesh)
+{
+    for (size_t i = 0; i < mesh->Targets.size(); ++i) {
+        VolumePod* volume = mesh->Targets[i];
+        SourcePod* source = FindSource(volume, mesh);
+        BrickMask dirty;
+        CreateMask(volume, dirty);
+        MarkSnapshot(*source, dirty);
+        volume->Sources.erase(volume->Sources.begin() + (source - &volume->Sources[0]));
+        RedoBricks(volume, dirty);
+    }
+    mesh->Targets.clear();
+}
+
+} // namespace OpenVOX
@@ -0,0 +1,216 @@
+#include "Common.hpp"
+#include <string.h>
+#include <float.h>
+
+#ifdef OPENVOX_WITH_GL
+#include <glew.h>
+#endif
+
+using namespace OpenVOX;
+
+static MeshPod* CreateMesh(VOXhandle context, VOXuint vertStride, VOXenum indexType, VOXuint triangleCount)
+{
+    ContextPod* contextPod = CastHandle<ContextPod>(context, HandleContext);
+    if (!contextPod) {
+        ReportError(0, "Invalid context handle.\n");
+        return 0;
+    }
+
+    if (indexType != VOX_TYPE_UINT32 && indexType != VOX_TYPE_UINT16) {
+        ReportError(contextPod, "Mesh indices must be VOX_TYPE_UINT32 or VOX_TYPE_UINT16.\n");
+        return 0;
+    }
+
+    MeshPod* mesh = new MeshPod;
+    mesh->Kind = HandleMesh;
+    mesh->Context = contextPod;
+    mesh->VertexBuffer = 0;
+    mesh->IndexBuffer = 0;
+    mesh->VertStride = vertStride ? vertStride : 3 * sizeof(float);
+    mesh->IndexType = indexType;
+    mesh->VertexCount = 0;
+    mesh->TriangleCount = triangleCount;
+    mesh->Revision = 0;
+    return mesh;
+}
+
+static void UpdateBounds(MeshPod* mesh)
+{
+    for (int c = 0; c < 3; ++c) {
+        mesh->MinCorner[c] = FLT_MAX;
+        mesh->MaxCorner[c] = -FLT_MAX;
+    }
+
+    const float* p = mesh->Positions.empty() ? 0 : &mesh->Positions[0];
+    for (VOXuint v = 0; v < mesh->VertexCount; ++v, p += 3) {
+        for (int c = 0; c < 3; ++c) {
+            if (p[c] < mesh->MinCorner[c]) mesh->MinCorner[c] = p[c];
+            if (p[c] > mesh->MaxCorner[c]) mesh->MaxCorner[c] = p[c];
+        }
+    }
+}
+
+static void CopyPositions(MeshPod* mesh, const void* vertexData)
+{
+    mesh->Positions.resize(mesh->VertexCount * 3);
+    const unsigned char* pSrc = (const unsigned char*) vertexData;
+    float* pDest = mesh->Positions.empty() ? 0 : &mesh->Positions[0];
+    for (VOXuint v = 0; v < mesh->VertexCount; ++v, pSrc += mesh->VertStride, pDest += 3)
+        memcpy(pDest, pSrc, 3 * sizeof(float));
+    UpdateBounds(mesh);
+    mesh->Revision++;
+}
+
+static void CopyIndices(MeshPod* mesh, const void* indexData)
+{
+    mesh->Indices.resize(mesh->TriangleCount * 3);
+    if (!indexData) {
+        for (VOXuint i = 0; i < mesh->TriangleCount * 3; ++i)
+            mesh->Indices[i] = i;
+    } else if (mesh->IndexType == VOX_TYPE_UINT16) {
+        const VOXushort* pSrc = (const VOXushort*) indexData;
+        for (VOXuint i = 0; i < mesh->TriangleCount * 3; ++i)
+            mesh->Indices[i] = pSrc[i];
+    } else if (!mesh->Indices.empty()) {
+        memcpy(&mesh->Indices[0], indexData, mesh->Indices.size() * sizeof(VOXuint));
+    }
+}
+
+VOXhandle voxRegisterMesh(
+    VOXhandle context,
+    GLuint vertexBuffer,
+    VOXuint vertStride,
+    VOXuint triangleCount)
+{
+    return voxRegisterMeshIndexed(context, vertexBuffer, 0, vertStride, VOX_TYPE_UINT32, triangleCount);
+}
+
+VOXhandle voxRegisterMeshIndexed(
+    VOXhandle context,
+    GLuint vertexBuffer,
+    GLuint indexBuffer,
+    VOXuint vertStride,
+    VOXenum indexType,
+    VOXuint triangleCount)
+{
+#ifdef OPENVOX_WITH_GL
+    MeshPod* mesh = CreateMesh(context, vertStride, indexType, triangleCount);
+    if (!mesh)
+        return 0;
+
+    mesh->VertexBuffer = vertexBuffer;
+    mesh->IndexBuffer = indexBuffer;
+    if (!RefreshMesh(mesh)) {
+        DeleteMesh(mesh);
+        return 0;
+    }
+    return mesh;
+#else
+    (void) vertexBuffer; (void) indexBuffer; (void) vertStride; (void) indexType; (void) triangleCount;
+    ReportError(CastHandle<ContextPod>(context, HandleContext),
+        "OpenVOX was built without OpenGL support; use voxRegisterMeshPtr.\n");
+    return 0;
+#endif
+}
+
+VOXhandle voxRegisterMeshPtr(
+    VOXhandle context,
+    const void* vertexData,
+    const void* indexData,
+    VOXuint vertStride,
+    VOXenum indexType,
+    VOXuint vertexCount,
+    VOXuint triangleCount)
+{
+    MeshPod* mesh = CreateMesh(context, vertStride, indexType, triangleCount);
+    if (!mesh)
+        return 0;
+
+    mesh->VertexCount = vertexCount;
+    CopyPositions(mesh, vertexData);
+    CopyIndices(mesh, indexData);
+
+    for (size_t i = 0; i < mesh->Indices.size(); ++i) {
+        if (mesh->Indices[i] >= vertexCount) {
+            ReportError(mesh->Context, "voxRegisterMeshPtr: index %u is out of range.\n", mesh->Indices[i]);
+            DeleteMesh(mesh);
+            return 0;
+        }
+    }
+    return mesh;
+}
+
+void voxUpdateMesh(
+    VOXhandle mesh,
+    VOXenum sourceFlags,
+    void* sourceData)
+{
+    MeshPod* meshPod = CastHandle<MeshPod>(mesh, HandleMesh);
+    if (!meshPod) {
+        ReportError(0, "voxUpdateMesh: invalid mesh handle.\n");
+        return;
+    }
+
+    if (SourceKind(sourceFlags) == VOX_SOURCE_GL_BUFFER) {
+        RefreshMesh(meshPod);
+        return;
+    }
+
+    if (SourceKind(sourceFlags) != VOX_SOURCE_CPU_MEMORY) {
+        ReportError(meshPod->Context, "voxUpdateMesh: vertices must come from CPU memory or the registered OpenGL buffer.\n");
+        return;
+    }
+
+    CopyPositions(meshPod, sourceData);
+}
+
+namespace OpenVOX {
+
+// Pulls the latest vertices and indices from the registered OpenGL buffers.
+bool RefreshMesh(MeshPod* mesh)
+{
+    if (!mesh->VertexBuffer)
+        return true;
+
+#ifdef OPENVOX_WITH_GL
+    GLint byteCount = 0;
+    glBindBuffer(GL_ARRAY_BUFFER, mesh->VertexBuffer);
+    glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &byteCount);
+    std::vector<unsigned char> vertices(byteCount);
+    if (byteCount)
+        glGetBufferSubData(GL_ARRAY_BUFFER, 0, byteCount, &vertices[0]);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    mesh->VertexCount = byteCount / mesh->VertStride;
+    CopyPositions(mesh, vertices.empty() ? 0 : &vertices[0]);
+
+    if (mesh->IndexBuffer) {
+        GLint indexSize = mesh->IndexType == VOX_TYPE_UINT16 ? sizeof(VOXushort) : sizeof(VOXuint);
+        std::vector<unsigned char> indices(mesh->TriangleCount * 3 * indexSize);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->IndexBuffer);
+        if (!indices.empty())
+            glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indices.size(), &indices[0]);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        CopyIndices(mesh, indices.empty() ? 0 : &indices[0]);
+    } else {
+        CopyIndices(mesh, 0);
+    }
+
+    if (glGetError() != GL_NO_ERROR) {
+        ReportError(mesh->Context, "Unable to read back OpenGL mesh buffers.\n");
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void DeleteMesh(MeshPod* mesh)
+{
+    DetachTargets(mesh);
+    mesh->Kind = (HandleKind) 0;
+    delete mesh;
+}
+
+} // namespace OpenVOX
@@ -0,0 +1,400 @@
+#include "Common.hpp"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+#define X 0
+#define Y 1
+#define Z 2
+
+namespace OpenVOX {
+
+// Narrow-band signed distance fields.  The source's non-zero voxels are the surface, at
+// distance zero; every voxel within VOX_PARAM_NARROW_BAND of it gets its distance, negative
+// inside, and everything further away is clamped to plus or minus the band.
+//
+// Only the bricks within reach of a surface voxel take part, so the work and the scratch
+// memory go with the surface area rather than the volume.  Distances solve the eikonal
+// equation by fast sweeping [Zhao, "A fast sweeping method for Eikonal equations"]: the
+// eight diagonal sweep orders run at once on copies of the band, in brick order and in
+// voxel order within the bricks, and the copies are merged by taking the minimum, until
+// nothing improves [Zhao, "Parallel implementations of the fast sweeping method"].
+//
+// Inside is wherever VOX_PARAM_SIGN_VOLUME is non-zero, typically a solid voxelization of
+// the same mesh.  Without one, inside is wherever a flood fill from the volume's border
+// cannot reach without crossing the surface.  The fill treats a brick beyond the band as a
+// single node, since nothing inside it can stop the fill, so it also stays with the band.
+
+static const float Infinity = HUGE_VALF;
+static const unsigned char SurfaceFlag = 1;
+static const unsigned char OutsideFlag = 2;
+static const unsigned char FixedFlag = 4;   // the surface, and its neighbours, which start exact
+
+struct BandPod {
+    int Bricks[3];                   // brick grid
+    int Extent[3];                   // voxels
+    std::vector<int> Slots;          // per brick: index into Coords, or -1 beyond the band
+    std::vector<int> Coords;         // brick coordinates of the band bricks, three apiece
+    std::vector<float> Values;       // BrickVoxels per band brick, x-fastest
+    std::vector<unsigned char> Flags;
+    std::vector<unsigned char> FarOutside; // per brick beyond the band, for the flood fill
+
+    size_t BrickIndex(int bx, int by, int bz) const { return bx + Bricks[X] * (by + (size_t) Bricks[Y] * bz); }
+    bool Contains(int x, int y, int z) const { return x >= 0 && y >= 0 && z >= 0 && x < Extent[X] && y < Extent[Y] && z < Extent[Z]; }
+
+    // Index of voxel (x, y, z) in Values and Flags, or -1 beyond the band.
+    long long Find(int x, int y, int z) const
+    {
+        int slot = Slots[BrickIndex(x >> BrickShift, y >> BrickShift, z >> BrickShift)];
+        if (slot < 0)
+            return -1;
+        const int mask = BrickSize - 1;
+        return (long long) slot * BrickVoxels + ((x & mask) + BrickSize * ((y & mask) + BrickSize * (z & mask)));
+    }
+};
+
+// Calls fn for every non-zero voxel of the source, skipping what the storage says is empty.
+static void ForEachSurfaceVoxel(const VolumePod* src, const std::function<void(int x, int y, int z)>& fn)
+{
+    if (src->Hash) {
+        ForEachVoxel(src->Hash, fn);
+        return;
+    }
+    if (src->Octree) {
+        ForEachOctreeVoxel(src->Octree, fn);
+        return;
+    }
+
+    const VOXuint bytesPerVoxel = src->BytesPerVoxel ? src->BytesPerVoxel : 1;
+    const unsigned char zero[16] = { 0 };
+    auto scanRow = [&](int x, int y, int z, int count, const unsigned char* row) {
+        for (int i = 0; i < count; ++i)
+            if (memcmp(row + i * bytesPerVoxel, zero, bytesPerVoxel))
+                fn(x + i, y, z);
+    };
+
+    if (src->Bricks && !GetBackground(src)) {
+        ForEachBrick(src, [&](int bx, int by, int bz, const unsigned char* brick) {
+            int x = bx * BrickSize;
+            int count = std::min((int) src->Width - x, BrickSize);
+            for (int z = bz * BrickSize; z < bz * BrickSize + BrickSize && z < (int) src->Depth; ++z)
+                for (int y = by * BrickSize; y < by * BrickSize + BrickSize && y < (int) src->Height; ++y)
+                    scanRow(x, y, z, count, brick + BrickVoxelOffset(src, x, y, z));
+        });
+        return;
+    }
+
+    std::vector<unsigned char> row((size_t) src->Width * bytesPerVoxel);
+    for (int z = 0; z < (int) src->Depth; ++z)
+        for (int y = 0; y < (int) src->Height; ++y) {
+            ReadVoxelSpan(src, 0, y, z, src->Width, &row[0]);
+            scanRow(0, y, z, src->Width, &row[0]);
+        }
+}
+
+// Allocates every brick within reach of a surface voxel and seeds the surface with zeros.
+static void CreateBand(const VolumePod* src, int reach, BandPod& band)
+{
+    const int extent[3] = { (int) src->Width, (int) src->Height, (int) src->Depth };
+    for (int c = 0; c < 3; ++c) {
+        band.Extent[c] = extent[c];
+        band.Bricks[c] = BrickCount(extent[c]);
+    }
+    band.Slots.assign((size_t) band.Bricks[X] * band.Bricks[Y] * band.Bricks[Z], -1);
+
+    std::vector<int> surface;
+    ForEachSurfaceVoxel(src, [&](int x, int y, int z) {
+        const int v[3] = { x, y, z };
+        int lo[3], hi[3];
+        for (int c = 0; c < 3; ++c) {
+            lo[c] = std::max(v[c] - reach, 0) >> BrickShift;
+            hi[c] = std::min(v[c] + reach, extent[c] - 1) >> BrickShift;
+        }
+        for (int bz = lo[Z]; bz <= hi[Z]; ++bz)
+            for (int by = lo[Y]; by <= hi[Y]; ++by)
+                for (int bx = lo[X]; bx <= hi[X]; ++bx)
+                    band.Slots[band.BrickIndex(bx, by, bz)] = 0;
+        surface.insert(surface.end(), v, v + 3);
+    });
+
+    int count = 0;
+    for (int bz = 0; bz < band.Bricks[Z]; ++bz)
+        for (int by = 0; by < band.Bricks[Y]; ++by)
+            for (int bx = 0; bx < band.Bricks[X]; ++bx) {
+                int& slot = band.Slots[band.BrickIndex(bx, by, bz)];
+                if (slot < 0)
+                    continue;
+                slot = count++;
+                band.Coords.push_back(bx);
+                band.Coords.push_back(by);
+                band.Coords.push_back(bz);
+            }
+
+    band.Values.assign((size_t) count * BrickVoxels, Infinity);
+    band.Flags.assign((size_t) count * BrickVoxels, 0);
+    for (size_t i = 0; i < surface.size(); i += 3) {
+        long long v = band.Find(surface[i], surface[i + 1], surface[i + 2]);
+        band.Values[v] = 0;
+        band.Flags[v] = SurfaceFlag | FixedFlag;
+    }
+
+    // First-order sweeps would put diagonal neighbours of the surface at 1, and neighbours
+    // boxed in by it at 1/sqrt(3), and carry the error outwards, so the nearest ring is
+    // set exactly and kept.
+    for (size_t i = 0; i < surface.size(); i += 3)
+        for (int dz = -1; dz <= 1; ++dz)
+            for (int dy = -1; dy <= 1; ++dy)
+                for (int dx = -1; dx <= 1; ++dx) {
+                    int x = surface[i] + dx, y = surface[i + 1] + dy, z = surface[i + 2] + dz;
+                    if (!band.Contains(x, y, z))
+                        continue;
+                    long long v = band.Find(x, y, z);
+                    band.Values[v] = std::min(band.Values[v], sqrtf((float) (dx * dx + dy * dy + dz * dz)));
+                    band.Flags[v] |= FixedFlag;
+                }
+}
+
+// The upwind solution of |grad u| = 1 from the smallest neighbour along each axis.
+static inline float SolveEikonal(float a, float b, float c)
+{
+    if (a > b) std::swap(a, b);
+    if (b > c) std::swap(b, c);
+    if (a > b) std::swap(a, b);
+    float u = a + 1;
+    if (u <= b)
+        return u;
+    u = 0.5f * (a + b + sqrtf(2 - (a - b) * (a - b)));
+    if (u <= c)
+        return u;
+    float s = a + b + c;
+    return (s + sqrtf(s * s - 3 * (a * a + b * b + c * c - 1))) / 3;
+}
+
+// One Gauss-Seidel sweep over the band, in the order given by the signs of step.
+static void Sweep(const BandPod& band, const int step[3], std::vector<float>& values)
+{
+    auto at = [&](int x, int y, int z) -> float {
+        if (!band.Contains(x, y, z))
+            return Infinity;
+        long long v = band.Find(x, y, z);
+        return v < 0 ? Infinity : values[v];
+    };
+
+    int first[3], last[3];
+    for (int c = 0; c < 3; ++c) {
+        first[c] = step[c] > 0 ? 0 : band.Bricks[c] - 1;
+        last[c] = step[c] > 0 ? band.Bricks[c] : -1;
+    }
+    for (int bz = first[Z]; bz != last[Z]; bz += step[Z])
+        for (int by = first[Y]; by != last[Y]; by += step[Y])
+            for (int bx = first[X]; bx != last[X]; bx += step[X]) {
+                int slot = band.Slots[band.BrickIndex(bx, by, bz)];
+                if (slot < 0)
+                    continue;
+                float* brick = &values[(size_t) slot * BrickVoxels];
+                const unsigned char* flags = &band.Flags[(size_t) slot * BrickVoxels];
+                for (int k = 0; k < BrickSize; ++k) {
+                    int lz = step[Z] > 0 ? k : BrickSize - 1 - k, z = bz * BrickSize + lz;
+                    for (int j = 0; j < BrickSize; ++j) {
+                        int ly = step[Y] > 0 ? j : BrickSize - 1 - j, y = by * BrickSize + ly;
+                        for (int i = 0; i < BrickSize; ++i) {
+                            int lx = step[X] > 0 ? i : BrickSize - 1 - i, x = bx * BrickSize + lx;
+                            int v = lx + BrickSize * (ly + BrickSize * lz);
+                            if (flags[v] & FixedFlag || !band.Contains(x, y, z))
+                                continue;
+                            float a = std::min(at(x - 1, y, z), at(x + 1, y, z));
+                            float b = std::min(at(x, y - 1, z), at(x, y + 1, z));
+                            float c = std::min(at(x, y, z - 1), at(x, y, z + 1));
+                            if (a == Infinity && b == Infinity && c == Infinity)
+                                continue;
+                            brick[v] = std::min(brick[v], SolveEikonal(a, b, c));
+                        }
+                    }
+                }
+            }
+}
+
+static void SweepBand(ContextPod* context, BandPod& band, float width)
+{
+    std::vector<float> copies[8];
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        ParallelFor(context->Pool, 8, 1,
+            [&](size_t begin, size_t end, unsigned int) {
+                for (size_t d = begin; d < end; ++d) {
+                    const int step[3] = { d & 1 ? -1 : 1, d & 2 ? -1 : 1, d & 4 ? -1 : 1 };
+                    copies[d] = band.Values;
+                    Sweep(band, step, copies[d]);
+                }
+            });
+
+        // Values past the band only feed the ones inside it, so they need not settle.
+        bool changed = false;
+        for (size_t v = 0; v < band.Values.size(); ++v) {
+            float u = band.Values[v];
+            for (int d = 0; d < 8; ++d)
+                u = std::min(u, copies[d][v]);
+            changed |= u < band.Values[v] - 1e-4f && u <= width;
+            band.Values[v] = u;
+        }
+        if (!changed)
+            break;
+    }
+}
+
+// Flags the band voxels that the border can reach without crossing the surface, and the
+// bricks beyond the band likewise.
+static void FloodOutside(BandPod& band)
+{
+    band.FarOutside.assign(band.Slots.size(), 0);
+    std::vector<int> bricks, voxels;
+
+    auto visitVoxel = [&](int x, int y, int z) {
+        if (!band.Contains(x, y, z))
+            return;
+        long long v = band.Find(x, y, z);
+        if (v < 0) {
+            size_t b = band.BrickIndex(x >> BrickShift, y >> BrickShift, z >> BrickShift);
+            if (!band.FarOutside[b]) {
+                band.FarOutside[b] = 1;
+                bricks.push_back((int) b);
+            }
+        } else if (!(band.Flags[v] & (SurfaceFlag | OutsideFlag))) {
+            band.Flags[v] |= OutsideFlag;
+            voxels.push_back(x);
+            voxels.push_back(y);
+            voxels.push_back(z);
+        }
+    };
+
+    // Everything on the border's faces that is not surface is outside.
+    const int* e = band.Extent;
+    for (int z = 0; z < e[Z]; ++z)
+        for (int y = 0; y < e[Y]; ++y) {
+            bool face = z == 0 || y == 0 || z == e[Z] - 1 || y == e[Y] - 1;
+            for (int x = 0; x < e[X]; x += face ? 1 : std::max(e[X] - 1, 1))
+                visitVoxel(x, y, z);
+        }
+
+    const int steps[6][3] = { { -1, 0, 0 }, { 1, 0, 0 }, { 0, -1, 0 }, { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 } };
+    while (!bricks.empty() || !voxels.empty()) {
+        if (!voxels.empty()) {
+            int z = voxels.back(); voxels.pop_back();
+            int y = voxels.back(); voxels.pop_back();
+            int x = voxels.back(); voxels.pop_back();
+            for (int s = 0; s < 6; ++s)
+                visitVoxel(x + steps[s][X], y + steps[s][Y], z + steps[s][Z]);
+            continue;
+        }
+
+        // A brick beyond the band spreads to the faces of its neighbours that touch it.
+        size_t b = bricks.back(); bricks.pop_back();
+        int bx = (int) (b % band.Bricks[X]), by = (int) (b / band.Bricks[X] % band.Bricks[Y]), bz = (int) (b / band.Bricks[X] / band.Bricks[Y]);
+        for (int s = 0; s < 6; ++s) {
+            int lo[3] = { bx * BrickSize, by * BrickSize, bz * BrickSize }, hi[3];
+            for (int c = 0; c < 3; ++c)
+                hi[c] = std::min(lo[c] + BrickSize, e[c]) - 1;
+            int axis = s / 2;
+            if (steps[s][axis] < 0)
+                lo[axis] = hi[axis] = lo[axis] - 1;
+            else
+                lo[axis] = hi[axis] = hi[axis] + 1;
+            for (int z = lo[Z]; z <= hi[Z]; ++z)
+                for (int y = lo[Y]; y <= hi[Y]; ++y)
+                    for (int x = lo[X]; x <= hi[X]; ++x)
+                        visitVoxel(x, y, z);
+        }
+    }
+}
+
+// Flags the band voxels where the sign volume is zero, and the bricks beyond the band whose
+// first voxel is; nothing separates the voxels of such a brick, so the rest agree.
+static void ReadOutside(BandPod& band, const VolumePod* sign)
+{
+    const VOXuint bytesPerVoxel = sign->BytesPerVoxel ? sign->BytesPerVoxel : 1;
+    const std::vector<unsigned char> zero(bytesPerVoxel, 0);
+    std::vector<unsigned char> row(BrickSize * bytesPerVoxel);
+    band.FarOutside.assign(band.Slots.size(), 0);
+    for (int bz = 0; bz < band.Bricks[Z]; ++bz)
+        for (int by = 0; by < band.Bricks[Y]; ++by)
+            for (int bx = 0; bx < band.Bricks[X]; ++bx) {
+                size_t b = band.BrickIndex(bx, by, bz);
+                int slot = band.Slots[b];
+                if (slot < 0) {
+                    ReadVoxelSpan(sign, bx * BrickSize, by * BrickSize, bz * BrickSize, 1, &row[0]);
+                    band.FarOutside[b] = !memcmp(&row[0], &zero[0], bytesPerVoxel);
+                    continue;
+                }
+                int x = bx * BrickSize, count = std::min(band.Extent[X] - x, BrickSize);
+                for (int z = bz * BrickSize; z < bz * BrickSize + BrickSize && z < band.Extent[Z]; ++z)
+                    for (int y = by * BrickSize; y < by * BrickSize + BrickSize && y < band.Extent[Y]; ++y) {
+                        ReadVoxelSpan(sign, x, y, z, count, &row[0]);
+                        long long v = band.Find(x, y, z);
+                        for (int i = 0; i < count; ++i)
+                            if (!(band.Flags[v + i] & SurfaceFlag) && !memcmp(&row[i * bytesPerVoxel], &zero[0], bytesPerVoxel))
+                                band.Flags[v + i] |= OutsideFlag;
+                    }
+            }
+}
+
+void TransformNarrowBand(VolumePod* dest, const VolumePod* src)
+{
+    if (dest->Type != VOX_TYPE_FLOAT32 || dest->Hash || dest->Octree) {
+        ReportError(dest->Context, "voxTransform: signed distances need a dense or sparse VOX_TYPE_FLOAT32 destination.\n");
+        return;
+    }
+
+    const ParamBlock& params = GetParams();
+    VolumePod* sign = CastHandle<VolumePod>(params.SignVolume, HandleVolume);
+    if (params.SignVolume && (!sign || sign->Width != src->Width || sign->Height != src->Height || sign->Depth != src->Depth)) {
+        ReportError(dest->Context, "voxTransform: VOX_PARAM_SIGN_VOLUME must be a volume matching the source.\n");
+        return;
+    }
+
+    // One voxel more than the band, so that the voxels at its edge have all their neighbours.
+    float width = params.NarrowBand > 0 ? params.NarrowBand : 3.0f;
+    BandPod band;
+    CreateBand(src, (int) ceilf(width) + 1, band);
+    if (sign)
+        ReadOutside(band, sign);
+    else
+        FloodOutside(band);
+    SweepBand(dest->Context, band, width);
+
+    // Everything starts out far outside; far inside bricks are filled, and the band written.
+    VOXuint outside, inside;
+    float negative = -width;
+    memcpy(&outside, &width, sizeof(outside));
+    memcpy(&inside, &negative, sizeof(inside));
+    DetachSources(dest);
+    FillVolume(dest, outside);
+    for (int bz = 0; bz < band.Bricks[Z]; ++bz)
+        for (int by = 0; by < band.Bricks[Y]; ++by)
+            for (int bx = 0; bx < band.Bricks[X]; ++bx) {
+                size_t b = band.BrickIndex(bx, by, bz);
+                if (band.Slots[b] < 0 && !band.FarOutside[b])
+                    FillBrick(dest, bx, by, bz, inside);
+            }
+
+    ParallelFor(dest->Context->Pool, band.Coords.size() / 3, 16,
+        [&](size_t begin, size_t end, unsigned int) {
+            float row[BrickSize];
+            for (size_t slot = begin; slot < end; ++slot) {
+                int x = band.Coords[slot * 3] * BrickSize;
+                int count = std::min(band.Extent[X] - x, BrickSize);
+                for (int lz = 0; lz < BrickSize; ++lz)
+                    for (int ly = 0; ly < BrickSize; ++ly) {
+                        int y = band.Coords[slot * 3 + 1] * BrickSize + ly, z = band.Coords[slot * 3 + 2] * BrickSize + lz;
+                        if (y >= band.Extent[Y] || z >= band.Extent[Z])
+                            continue;
+                        size_t v = slot * BrickVoxels + BrickSize * (ly + BrickSize * lz);
+                        for (int i = 0; i < count; ++i) {
+                            float d = std::min(band.Values[v + i], width);
+                            row[i] = band.Flags[v + i] & (SurfaceFlag | OutsideFlag) ? d : -d;
+                        }
+                        WriteVoxelSpan(dest, x, y, z, count, (const unsigned char*) row);
+                    }
+            }
+        });
+}
+
+} // namespace OpenVOX
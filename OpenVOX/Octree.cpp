@@ -0,0 +1,343 @@
+#include "Common.hpp"
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <atomic>
+
+using namespace OpenVOX;
+
+namespace OpenVOX {
+
+// Octree volumes hold a sparse voxel octree over the Morton codes of their set voxels.
+// Level 0 is the voxels themselves; a node at level L covers a 2^L cube and stores a mask
+// of its non-empty children along with the index of the first of them in level L - 1,
+// where siblings are contiguous.  Level 1 masks are the voxels, so voxels cost no more
+// than a bit each.  The root sits alone at the top level.
+//
+// The tree is rebuilt, never edited: voxelization appends codes to a flat buffer from every
+// thread, then the codes are radix sorted, deduplicated and folded up a level at a time.
+
+struct OctreeLevel {
+    std::vector<unsigned char> Masks;
+    std::vector<VOXuint> FirstChild;  // unused at level 1
+};
+
+struct OctreePod {
+    int Depth;                        // levels above the voxels; the root covers 2^Depth
+    std::vector<OctreeLevel> Levels;  // indexed by level, 1..Depth
+    size_t Count;
+
+    // Codes gathered by the current voxelization pass.  Writers claim space with a single
+    // atomic add, and keep counting past the end so that a retry knows its exact size.
+    std::vector<VOXuint64> Pending;
+    std::atomic<size_t> PendingCount;
+};
+
+// Spreads the low 21 bits of v two bits apart.
+static inline VOXuint64 SpreadBits(VOXuint64 v)
+{
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffffull;
+    v = (v | v << 16) & 0x1f0000ff0000ffull;
+    v = (v | v << 8) & 0x100f00f00f00f00full;
+    v = (v | v << 4) & 0x10c30c30c30c30c3ull;
+    v = (v | v << 2) & 0x1249249249249249ull;
+    return v;
+}
+
+static inline VOXuint64 CompactBits(VOXuint64 v)
+{
+    v &= 0x1249249249249249ull;
+    v = (v ^ (v >> 2)) & 0x10c30c30c30c30c3ull;
+    v = (v ^ (v >> 4)) & 0x100f00f00f00f00full;
+    v = (v ^ (v >> 8)) & 0x1f0000ff0000ffull;
+    v = (v ^ (v >> 16)) & 0x1f00000000ffffull;
+    v = (v ^ (v >> 32)) & 0x1fffff;
+    return v;
+}
+
+static inline VOXuint64 MortonCode(int x, int y, int z)
+{
+    return SpreadBits(x) | SpreadBits(y) << 1 | SpreadBits(z) << 2;
+}
+
+OctreePod* CreateOctree(const VolumePod* volume)
+{
+    OctreePod* octree = new OctreePod;
+    VOXuint extent = std::max(volume->Width, std::max(volume->Height, volume->Depth));
+    octree->Depth = 1;
+    while ((1u << octree->Depth) < extent)
+        octree->Depth++;
+    octree->Levels.resize(octree->Depth + 1);
+    octree->Count = 0;
+    octree->PendingCount.store(0);
+    return octree;
+}
+
+void DestroyOctree(OctreePod* octree)
+{
+    delete octree;
+}
+
+void ClearOctree(OctreePod* octree)
+{
+    for (size_t level = 0; level < octree->Levels.size(); ++level) {
+        std::vector<unsigned char>().swap(octree->Levels[level].Masks);
+        std::vector<VOXuint>().swap(octree->Levels[level].FirstChild);
+    }
+    octree->Count = 0;
+}
+
+size_t GetOctreeCount(const OctreePod* octree)
+{
+    return octree->Count;
+}
+
+// Walks down from the root towards the voxel and returns the level of the largest empty
+// node that contains it, or -1 if the voxel is set.
+static int FindEmptyLevel(const OctreePod* octree, int x, int y, int z)
+{
+    if (octree->Levels[octree->Depth].Masks.empty())
+        return octree->Depth;
+
+    VOXuint64 code = MortonCode(x, y, z);
+    size_t node = 0;
+    for (int level = octree->Depth; level >= 1; --level) {
+        unsigned char mask = octree->Levels[level].Masks[node];
+        int child = (int) (code >> (3 * (level - 1))) & 7;
+        if (!(mask & (1 << child)))
+            return level - 1;
+        if (level > 1)
+            node = octree->Levels[level].FirstChild[node] + BitCount(mask & ((1u << child) - 1));
+    }
+    return -1;
+}
+
+bool FindOctreeVoxel(const OctreePod* octree, int x, int y, int z)
+{
+    return FindEmptyLevel(octree, x, y, z) < 0;
+}
+
+static void VisitNode(const OctreePod* octree, int level, size_t node, VOXuint64 prefix,
+                      const std::function<void(VOXuint64 code)>& fn)
+{
+    unsigned char mask = octree->Levels[level].Masks[node];
+    size_t child = level > 1 ? octree->Levels[level].FirstChild[node] : 0;
+    for (int c = 0; c < 8; ++c) {
+        if (!(mask & (1 << c)))
+            continue;
+        if (level == 1)
+            fn(prefix << 3 | c);
+        else
+            VisitNode(octree, level - 1, child++, prefix << 3 | c, fn);
+    }
+}
+
+static void ForEachCode(const OctreePod* octree, const std::function<void(VOXuint64 code)>& fn)
+{
+    if (!octree->Levels[octree->Depth].Masks.empty())
+        VisitNode(octree, octree->Depth, 0, 0, fn);
+}
+
+// Visits the voxels in Morton order.
+void ForEachOctreeVoxel(const OctreePod* octree, const std::function<void(int x, int y, int z)>& fn)
+{
+    ForEachCode(octree, [&](VOXuint64 code) {
+        fn((int) CompactBits(code), (int) CompactBits(code >> 1), (int) CompactBits(code >> 2));
+    });
+}
+
+void AppendOctreeVoxels(OctreePod* octree, int x, int y, int z, unsigned long long mask)
+{
+    size_t first = octree->PendingCount.fetch_add(BitCount(mask), std::memory_order_relaxed);
+    for (size_t i = first; mask; mask &= mask - 1, ++i)
+        if (i < octree->Pending.size())
+            octree->Pending[i] = MortonCode(x + LowestBit(mask), y, z);
+}
+
+// Least-significant-digit radix sort, eight bits per pass.  Each pass histograms and then
+// scatters a handful of contiguous chunks in parallel, which keeps the sort stable.
+static void RadixSort(ThreadPool* pool, std::vector<VOXuint64>& keys, int bits)
+{
+    const size_t count = keys.size();
+    const size_t chunkCount = std::max<size_t>(1, std::min<size_t>(GetThreadCount(pool) * 4, count / 65536));
+    const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+    std::vector<VOXuint64> scratch(count);
+    std::vector<size_t> offsets(chunkCount * 256);
+
+    for (int shift = 0; shift < bits; shift += 8) {
+        std::fill(offsets.begin(), offsets.end(), 0);
+        ParallelFor(pool, chunkCount, 1, [&](size_t begin, size_t end, unsigned int) {
+            for (size_t chunk = begin; chunk < end; ++chunk) {
+                size_t* histogram = &offsets[chunk * 256];
+                for (size_t i = chunk * chunkSize; i < std::min(count, (chunk + 1) * chunkSize); ++i)
+                    histogram[(keys[i] >> shift) & 0xff]++;
+            }
+        });
+
+        // Digit-major prefix sum, so that each chunk scatters after the chunks before it.
+        size_t sum = 0;
+        for (int digit = 0; digit < 256; ++digit)
+            for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+                size_t n = offsets[chunk * 256 + digit];
+                offsets[chunk * 256 + digit] = sum;
+                sum += n;
+            }
+
+        ParallelFor(pool, chunkCount, 1, [&](size_t begin, size_t end, unsigned int) {
+            for (size_t chunk = begin; chunk < end; ++chunk) {
+                size_t* cursor = &offsets[chunk * 256];
+                for (size_t i = chunk * chunkSize; i < std::min(count, (chunk + 1) * chunkSize); ++i)
+                    scratch[cursor[(keys[i] >> shift) & 0xff]++] = keys[i];
+            }
+        });
+        keys.swap(scratch);
+    }
+}
+
+// Folds sorted, unique voxel codes into the levels of the tree.
+static void BuildLevels(OctreePod* octree, const std::vector<VOXuint64>& codes)
+{
+    ClearOctree(octree);
+    octree->Count = codes.size();
+    if (codes.empty())
+        return;
+
+    std::vector<VOXuint64> keys(codes), parents;
+    for (int level = 1; level <= octree->Depth; ++level) {
+        OctreeLevel& nodes = octree->Levels[level];
+        parents.clear();
+        for (size_t i = 0; i < keys.size(); ++i) {
+            VOXuint64 parent = keys[i] >> 3;
+            if (parents.empty() || parents.back() != parent) {
+                parents.push_back(parent);
+                nodes.Masks.push_back(0);
+                if (level > 1)
+                    nodes.FirstChild.push_back((VOXuint) i);
+            }
+            nodes.Masks.back() |= (unsigned char) (1 << (keys[i] & 7));
+        }
+        keys.swap(parents);
+    }
+}
+
+// Voxelizes the mesh's surface into the octree, on top of the voxels already in it.
+void VoxelizeOctree(MeshPod* mesh, VolumePod* volume, const GridPod& grid)
+{
+    OctreePod* octree = volume->Octree;
+    ContextPod* context = mesh->Context;
+
+    // A triangle's voxels are often shared with its neighbours, so allow for repeats.
+    octree->Pending.resize(2 * EstimateSurfaceVoxels(mesh, grid));
+    for (;;) {
+        octree->PendingCount.store(0);
+        VoxelizeSurface(mesh, volume, grid, 0, 0);
+        size_t needed = octree->PendingCount.load();
+        if (needed <= octree->Pending.size()) {
+            octree->Pending.resize(needed);
+            break;
+        }
+        octree->Pending.resize(needed);
+    }
+
+    std::vector<VOXuint64> codes;
+    codes.swap(octree->Pending);
+    ForEachCode(octree, [&](VOXuint64 code) { codes.push_back(code); });
+
+    RadixSort(context->Pool, codes, 3 * octree->Depth);
+    codes.erase(std::unique(codes.begin(), codes.end()), codes.end());
+    BuildLevels(octree, codes);
+}
+
+// For the ray caster: the level of the largest empty cube around the voxel, or -1 if the
+// voxel is set.  Other storages only know about single voxels.
+static int FindEmptyLevel(const VolumePod* volume, int x, int y, int z)
+{
+    if (volume->Octree)
+        return FindEmptyLevel(volume->Octree, x, y, z);
+
+    static const unsigned char zero[16] = { 0 };
+    unsigned char voxel[16] = { 0 };
+    ReadVoxelSpan(volume, x, y, z, 1, voxel);
+    return memcmp(voxel, zero, sizeof(voxel)) ? -1 : 0;
+}
+
+} // namespace OpenVOX
+
+VOXbool voxCastRay(
+    VOXhandle volume,
+    const VOXfloat origin[3],
+    const VOXfloat direction[3],
+    VOXfloat maxDistance,
+    VOXuint hit[3],
+    VOXfloat* distance)
+{
+    VolumePod* volumePod = CastHandle<VolumePod>(volume, HandleVolume);
+    if (!volumePod || !origin || !direction || !hit) {
+        ReportError(0, "voxCastRay: invalid volume handle or argument.\n");
+        return VOX_FALSE;
+    }
+
+    const int extent[3] = { (int) volumePod->Width, (int) volumePod->Height, (int) volumePod->Depth };
+    double o[3], d[3];
+    for (int c = 0; c < 3; ++c) {
+        o[c] = origin[c];
+        d[c] = direction[c];
+    }
+
+    // Clip the ray to the volume's box.
+    double tEnter = 0, tLeave = maxDistance;
+    for (int c = 0; c < 3; ++c) {
+        if (d[c] == 0) {
+            if (o[c] < 0 || o[c] >= extent[c])
+                return VOX_FALSE;
+            continue;
+        }
+        double t0 = (0 - o[c]) / d[c], t1 = (extent[c] - o[c]) / d[c];
+        tEnter = std::max(tEnter, std::min(t0, t1));
+        tLeave = std::min(tLeave, std::max(t0, t1));
+    }
+    if (tEnter > tLeave)
+        return VOX_FALSE;
+
+    int v[3];
+    for (int c = 0; c < 3; ++c)
+        v[c] = std::min(extent[c] - 1, std::max(0, (int) floor(o[c] + d[c] * tEnter)));
+
+    // Step from one empty cube to the next; each step leaves the current cube through the
+    // face the ray exits first.
+    double t = tEnter;
+    for (;;) {
+        int level = FindEmptyLevel(volumePod, v[0], v[1], v[2]);
+        if (level < 0) {
+            for (int c = 0; c < 3; ++c)
+                hit[c] = v[c];
+            if (distance)
+                *distance = (VOXfloat) t;
+            return VOX_TRUE;
+        }
+
+        int size = 1 << level, base[3];
+        double tExit = HUGE_VAL;
+        int axis = 0;
+        for (int c = 0; c < 3; ++c) {
+            base[c] = v[c] & ~(size - 1);
+            if (d[c] == 0)
+                continue;
+            double tc = ((d[c] > 0 ? base[c] + size : base[c]) - o[c]) / d[c];
+            if (tc < tExit) {
+                tExit = tc;
+                axis = c;
+            }
+        }
+        if (tExit > tLeave)
+            return VOX_FALSE;
+
+        t = std::max(t, tExit);
+        for (int c = 0; c < 3; ++c)
+            v[c] = std::min(base[c] + size - 1, std::max(base[c], (int) floor(o[c] + d[c] * t)));
+        v[axis] = d[axis] > 0 ? base[axis] + size : base[axis] - 1;
+        if (v[axis] < 0 || v[axis] >= extent[axis])
+            return VOX_FALSE;
+    }
+}
@@ -0,0 +1,208 @@
+#include "Common.hpp"
+#include <math.h>
+#include <string.h>
+
+using namespace OpenVOX;
+
+// Like OpenGL, parameters are global state that is latched by the operations that read it.
+static ParamBlock Params;
+
+namespace OpenVOX {
+
+const ParamBlock& GetParams()
+{
+    return Params;
+}
+
+} // namespace OpenVOX
+
+void voxGetParamv(VOXenum param, void* value)
+{
+    switch (param)
+    {
+        case VOX_PARAM_CLEAR_VALUE:     *(VOXuint*) value = Params.ClearValue; break;
+        case VOX_PARAM_VOXELIZE_BOUNDS: memcpy(value, Params.VoxelizeBounds, sizeof(Params.VoxelizeBounds)); break;
+        case VOX_PARAM_THREAD_COUNT:    *(VOXuint*) value = Params.ThreadCount; break;
+        case VOX_PARAM_SIMD_WIDTH:      *(VOXuint*) value = Params.SimdWidth; break;
+        case VOX_PARAM_PLANE_SPANS:     *(VOXbool*) value = Params.PlaneSpans; break;
+        case VOX_PARAM_INCREMENTAL:     *(VOXbool*) value = Params.Incremental; break;
+        case VOX_PARAM_VOLUME_STORAGE:  *(VOXenum*) value = Params.VolumeStorage ? Params.VolumeStorage : VOX_STORAGE_DENSE; break;
+        case VOX_PARAM_VOLUME_LAYOUT:   *(VOXenum*) value = Params.VolumeLayout ? Params.VolumeLayout : VOX_LAYOUT_LINEAR; break;
+        case VOX_PARAM_REFERENCE_MARGIN: *(VOXfloat*) value = Params.ReferenceMargin; break;
+        case VOX_PARAM_NARROW_BAND:     *(VOXfloat*) value = Params.NarrowBand > 0 ? Params.NarrowBand : 3.0f; break;
+        case VOX_PARAM_SIGN_VOLUME:     *(VOXhandle*) value = Params.SignVolume; break;
+        case VOX_PARAM_FLUID_OBSTACLES: *(VOXhandle*) value = Params.FluidObstacles; break;
+        case VOX_PARAM_FLUID_VELOCITY:  *(VOXhandle*) value = Params.FluidVelocity; break;
+        case VOX_PARAM_FLUID_TIME_STEP: *(VOXfloat*) value = Params.FluidTimeStep ? Params.FluidTimeStep : 1.0f; break;
+        default: ReportError(0, "voxGetParamv: unsupported parameter 0x%8.8x\n", param);
+    }
+}
+
+void voxResetParamv(VOXenum param)
+{
+    switch (param)
+    {
+        case VOX_PARAM_CLEAR_VALUE:     Params.ClearValue = 0; break;
+        case VOX_PARAM_VOXELIZE_BOUNDS:
+            Params.VoxelizeBoundsEnable = VOX_FALSE;
+            memset(Params.VoxelizeBounds, 0, sizeof(Params.VoxelizeBounds));
+            break;
+        case VOX_PARAM_THREAD_COUNT:    Params.ThreadCount = 0; break;
+        case VOX_PARAM_SIMD_WIDTH:      Params.SimdWidth = 0; break;
+        case VOX_PARAM_PLANE_SPANS:     Params.PlaneSpans = VOX_FALSE; break;
+        case VOX_PARAM_VOLUME_STORAGE:  Params.VolumeStorage = VOX_STORAGE_DENSE; break;
+        case VOX_PARAM_VOLUME_LAYOUT:   Params.VolumeLayout = VOX_LAYOUT_LINEAR; break;
+        case VOX_PARAM_INCREMENTAL:     Params.Incremental = VOX_FALSE; break;
+        case VOX_PARAM_REFERENCE_MARGIN: Params.ReferenceMargin = 0; break;
+        case VOX_PARAM_NARROW_BAND:     Params.NarrowBand = 0; break;
+        case VOX_PARAM_SIGN_VOLUME:     Params.SignVolume = 0; break;
+        case VOX_PARAM_FLUID_OBSTACLES: Params.FluidObstacles = 0; break;
+        case VOX_PARAM_FLUID_VELOCITY:  Params.FluidVelocity = 0; break;
+        case VOX_PARAM_FLUID_TIME_STEP: Params.FluidTimeStep = 0; break;
+        default: ReportError(0, "voxResetParamv: unsupported parameter 0x%8.8x\n", param);
+    }
+}
+
+void voxSetParam1h(VOXenum param, VOXhandle value)
+{
+    switch (param)
+    {
+        case VOX_PARAM_SIGN_VOLUME: Params.SignVolume = value; break;
+        case VOX_PARAM_FLUID_OBSTACLES: Params.FluidObstacles = value; break;
+        case VOX_PARAM_FLUID_VELOCITY: Params.FluidVelocity = value; break;
+        default: ReportError(0, "voxSetParam1h: unsupported parameter 0x%8.8x\n", param);
+    }
+}
+
+namespace OpenVOX {
+
+// Handle parameters are cleared when their object is deleted, rather than left dangling.
+void ForgetParamHandle(VOXhandle handle)
+{
+    if (Params.SignVolume == handle)
+        Params.SignVolume = 0;
+    if (Params.FluidObstacles == handle)
+        Params.FluidObstacles = 0;
+    if (Params.FluidVelocity == handle)
+        Params.FluidVelocity = 0;
+}
+
+} // namespace OpenVOX
+
+void voxSetParam1b(VOXenum param, VOXbool value)
+{
+    switch (param)
+    {
+        case VOX_PARAM_PLANE_SPANS: Params.PlaneSpans = value; break;
+        case VOX_PARAM_INCREMENTAL: Params.Incremental = value; break;
+        default: ReportError(0, "voxSetParam1b: unsupported parameter 0x%8.8x\n", param);
+    }
+}
+
+// The scalar and vector entry points funnel into these.  Every unsigned parameter is a
+// single value; for the float ones, count is the number of values the caller supplied, or
+// ~0u when it passed an array and is trusted to have provided enough.
+static void SetParamui(const char* entry, VOXenum param, const VOXuint* value)
+{
+    switch (param)
+    {
+        case VOX_PARAM_CLEAR_VALUE:  Params.ClearValue = value[0]; return;
+        case VOX_PARAM_THREAD_COUNT: Params.ThreadCount = value[0]; return;
+        case VOX_PARAM_SIMD_WIDTH:   Params.SimdWidth = value[0]; return;
+        case VOX_PARAM_VOLUME_STORAGE:
+            if (value[0] != VOX_STORAGE_DENSE && value[0] != VOX_STORAGE_SPARSE && value[0] != VOX_STORAGE_HASH &&
+                value[0] != VOX_STORAGE_OCTREE)
+                break;
+            Params.VolumeStorage = (VOXenum) value[0];
+            return;
+        case VOX_PARAM_VOLUME_LAYOUT:
+            if (value[0] != VOX_LAYOUT_LINEAR && value[0] != VOX_LAYOUT_TILED)
+                break;
+            Params.VolumeLayout = (VOXenum) value[0];
+            return;
+        default: break;
+    }
+    ReportError(0, "%s: unsupported parameter 0x%8.8x\n", entry, param);
+}
+
+static void SetParamf(const char* entry, VOXenum param, const VOXfloat* value, unsigned int count)
+{
+    switch (param)
+    {
+        case VOX_PARAM_VOXELIZE_BOUNDS:
+            if (count < 6)
+                break;
+            memcpy(Params.VoxelizeBounds, value, sizeof(Params.VoxelizeBounds));
+            Params.VoxelizeBoundsEnable = VOX_TRUE;
+            return;
+        case VOX_PARAM_REFERENCE_MARGIN: Params.ReferenceMargin = value[0]; return;
+        case VOX_PARAM_NARROW_BAND:
+            if (!(value[0] > 0))
+                break;
+            Params.NarrowBand = value[0];
+            return;
+        case VOX_PARAM_FLUID_TIME_STEP:
+            if (value[0] == 0 || !isfinite(value[0]))
+                break;
+            Params.FluidTimeStep = value[0];
+            return;
+        default: break;
+    }
+    ReportError(0, "%s: unsupported parameter 0x%8.8x\n", entry, param);
+}
+
+void voxSetParam1ui(VOXenum param, VOXuint x)
+{
+    SetParamui("voxSetParam1ui", param, &x);
+}
+
+void voxSetParam2ui(VOXenum param, VOXuint x, VOXuint y)
+{
+    VOXuint v[] = { x, y };
+    SetParamui("voxSetParam2ui", param, v);
+}
+
+void voxSetParam3ui(VOXenum param, VOXuint x, VOXuint y, VOXuint z)
+{
+    VOXuint v[] = { x, y, z };
+    SetParamui("voxSetParam3ui", param, v);
+}
+
+void voxSetParam4ui(VOXenum param, VOXuint x, VOXuint y, VOXuint z, VOXuint w)
+{
+    VOXuint v[] = { x, y, z, w };
+    SetParamui("voxSetParam4ui", param, v);
+}
+
+void voxSetParamuiv(VOXenum param, VOXuint* value)
+{
+    SetParamui("voxSetParamuiv", param, value);
+}
+
+void voxSetParam1f(VOXenum param, VOXfloat x)
+{
+    SetParamf("voxSetParam1f", param, &x, 1);
+}
+
+void voxSetParam2f(VOXenum param, VOXfloat x, VOXfloat y)
+{
+    VOXfloat v[] = { x, y };
+    SetParamf("voxSetParam2f", param, v, 2);
+}
+
+void voxSetParam3f(VOXenum param, VOXfloat x, VOXfloat y, VOXfloat z)
+{
+    VOXfloat v[] = { x, y, z };
+    SetParamf("voxSetParam3f", param, v, 3);
+}
+
+void voxSetParam4f(VOXenum param, VOXfloat x, VOXfloat y, VOXfloat z, VOXfloat w)
+{
+    VOXfloat v[] = { x, y, z, w };
+    SetParamf("voxSetParam4f", param, v, 4);
+}
+
+void voxSetParamfv(VOXenum param, VOXfloat* value)
+{
+    SetParamf("voxSetParamfv", param, value, ~0u);
+}
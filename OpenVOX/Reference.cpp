@@ -0,0 +1,130 @@
+#include "Common.hpp"
+#include <math.h>
+#include <algorithm>
+
+#define X 0
+#define Y 1
+#define Z 2
+
+namespace OpenVOX {
+
+// The reference surface voxelizer: slow, but with no shortcuts, for checking the fast paths
+// against.  It uses the grid of the kernels, where voxel (x, y, z) is the box of one voxel
+// centered at (x, y, z) in voxel units, and sets every voxel whose closed box overlaps the
+// closed triangle.  The test is the full separating-axis test, in double precision, over all
+// thirteen axes, on vertices mapped to voxel units in double precision as well.  An axis
+// separates only if the projections are strictly apart, so touching counts as overlapping.
+// Degenerate triangles come out right without special cases: their zero axes never separate,
+// and what is left is the test for the segment or point they collapse to.
+//
+// VOX_PARAM_REFERENCE_MARGIN grows every box by that many voxels on each side, or shrinks it
+// if negative.  Voxelizing with a small negative and a small positive margin brackets what
+// the exact answer may be once rounding is taken into account.
+
+// True if the projections of the triangle and of the box onto axis a are strictly apart.
+static inline bool Separates(const double a[3], const double v[3][3], double h)
+{
+    double p0 = a[X] * v[0][X] + a[Y] * v[0][Y] + a[Z] * v[0][Z];
+    double p1 = a[X] * v[1][X] + a[Y] * v[1][Y] + a[Z] * v[1][Z];
+    double p2 = a[X] * v[2][X] + a[Y] * v[2][Y] + a[Z] * v[2][Z];
+    double r = h * (fabs(a[X]) + fabs(a[Y]) + fabs(a[Z]));
+    return std::min(p0, std::min(p1, p2)) > r || std::max(p0, std::max(p1, p2)) < -r;
+}
+
+static bool OverlapsBox(const double p[3][3], const double axes[13][3], int x, int y, int z, double h)
+{
+    double v[3][3];
+    for (int i = 0; i < 3; ++i) {
+        v[i][X] = p[i][X] - x;
+        v[i][Y] = p[i][Y] - y;
+        v[i][Z] = p[i][Z] - z;
+    }
+    for (int a = 0; a < 13; ++a)
+        if (Separates(axes[a], v, h))
+            return false;
+    return true;
+}
+
+static void VoxelizeReferenceTriangle(const MeshPod* mesh, VOXuint triangle, VolumePod* volume,
+                                      const double scale[3], const double offset[3], double h)
+{
+    const int extent[3] = { (int) volume->Width, (int) volume->Height, (int) volume->Depth };
+    const VOXuint* indices = &mesh->Indices[triangle * 3];
+    double p[3][3];
+    for (int i = 0; i < 3; ++i) {
+        if (indices[i] >= mesh->VertexCount)
+            return;
+        const float* v = &mesh->Positions[indices[i] * 3];
+        for (int c = 0; c < 3; ++c) {
+            p[i][c] = ((double) v[c] + offset[c]) * scale[c];
+            if (!(fabs(p[i][c]) < 1e30))
+                return;
+        }
+    }
+
+    // The box axes, the normal, and the nine edge/box-axis cross products.
+    double e[3][3], axes[13][3] = {{0}};
+    for (int c = 0; c < 3; ++c) {
+        e[0][c] = p[1][c] - p[0][c];
+        e[1][c] = p[2][c] - p[1][c];
+        e[2][c] = p[0][c] - p[2][c];
+        axes[c][c] = 1;
+    }
+    axes[3][X] = e[0][Y] * e[1][Z] - e[0][Z] * e[1][Y];
+    axes[3][Y] = e[0][Z] * e[1][X] - e[0][X] * e[1][Z];
+    axes[3][Z] = e[0][X] * e[1][Y] - e[0][Y] * e[1][X];
+    for (int i = 0; i < 3; ++i) {
+        double* ex = axes[4 + 3 * i];
+        double* ey = axes[5 + 3 * i];
+        double* ez = axes[6 + 3 * i];
+        ex[Y] = -e[i][Z]; ex[Z] = e[i][Y];  // e x (1, 0, 0)
+        ey[X] = e[i][Z];  ey[Z] = -e[i][X]; // e x (0, 1, 0)
+        ez[X] = -e[i][Y]; ez[Y] = e[i][X];  // e x (0, 0, 1)
+    }
+
+    // Voxel i reaches [i - h, i + h], so these are all the boxes the triangle's bounds touch.
+    int lo[3], hi[3];
+    for (int c = 0; c < 3; ++c) {
+        double mn = std::min(p[0][c], std::min(p[1][c], p[2][c]));
+        double mx = std::max(p[0][c], std::max(p[1][c], p[2][c]));
+        double first = std::max(ceil(mn - h), 0.0);
+        double last = std::min(floor(mx + h), extent[c] - 1.0);
+        if (first > last)
+            return;
+        lo[c] = (int) first;
+        hi[c] = (int) last;
+    }
+
+    for (int z = lo[Z]; z <= hi[Z]; ++z)
+        for (int y = lo[Y]; y <= hi[Y]; ++y)
+            for (int x0 = lo[X]; x0 <= hi[X]; x0 += 64) {
+                int count = std::min(hi[X] + 1 - x0, 64);
+                unsigned long long mask = 0;
+                for (int i = 0; i < count; ++i)
+                    if (OverlapsBox(p, axes, x0 + i, y, z, h))
+                        mask |= 1ull << i;
+                if (mask)
+                    WriteRow(volume, x0, y, z, mask);
+            }
+}
+
+void VoxelizeReference(MeshPod* mesh, VolumePod* volume, const float minCorner[3], const float maxCorner[3])
+{
+    double scale[3], offset[3];
+    VOXuint extent[3] = { volume->Width, volume->Height, volume->Depth };
+    for (int c = 0; c < 3; ++c) {
+        scale[c] = extent[c] / ((double) maxCorner[c] - (double) minCorner[c]);
+        offset[c] = -(double) minCorner[c];
+    }
+    double h = 0.5 + GetParams().ReferenceMargin;
+    if (h < 0)
+        return;
+
+    ParallelFor(mesh->Context->Pool, mesh->TriangleCount, 16,
+        [&](size_t begin, size_t end, unsigned int) {
+            for (size_t t = begin; t < end; ++t)
+                VoxelizeReferenceTriangle(mesh, (VOXuint) t, volume, scale, offset, h);
+        });
+}
+
+} // namespace OpenVOX
@@ -0,0 +1,106 @@
+#include "Common.hpp"
+
+#ifdef __AVX512F__
+#include <immintrin.h>
+
+#define X 0
+#define Y 1
+#define Z 2
+
+namespace OpenVOX {
+
+// Evaluates one separating axis for sixteen voxels; p0 and p1 are the projections of two
+// triangle vertices, and lanes where the triangle lies entirely outside [-rad, +rad] are cleared.
+#define AXISTEST(p0, p1, rad)                                                                     \
+    inside &= ~(_mm512_cmp_ps_mask(_mm512_min_ps(p0, p1), rad, _CMP_GT_OQ) |                      \
+                _mm512_cmp_ps_mask(_mm512_max_ps(p0, p1), _mm512_sub_ps(zero, rad), _CMP_LT_OQ));
+
+// Same overlap tests as TestRowScalar, evaluated for sixteen consecutive voxels per step.
+// Only the Y and Z tests vary along the row; the X tests are hoisted out by TestRowAxisX.
+unsigned long long TestRowAvx512(const TrianglePod& tri, const GridPod& grid, int x, int count, int y, int z)
+{
+    if (!TestRowAxisX(tri, grid, y, z))
+        return 0;
+
+    const float (*e)[3] = tri.E;
+    const float (*fe)[3] = tri.FE;
+    const float* h = grid.HalfSize;
+    float cy = y * grid.Delta[Y], cz = z * grid.Delta[Z];
+    float v0y = tri.V[0][Y] - cy, v1y = tri.V[1][Y] - cy, v2y = tri.V[2][Y] - cy;
+    float v0z = tri.V[0][Z] - cz, v1z = tri.V[1][Z] - cz, v2z = tri.V[2][Z] - cz;
+
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 delta = _mm512_set1_ps(grid.Delta[X]);
+    const __m512i lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    // Y-tests: p = -a*v[X] + b*v[Z], where only the first term changes along the row.
+    const __m512 yA0 = _mm512_set1_ps(-e[0][Z]), yB0 = _mm512_set1_ps(e[0][X]);
+    const __m512 yA1 = _mm512_set1_ps(-e[1][Z]), yB1 = _mm512_set1_ps(e[1][X]);
+    const __m512 yA2 = _mm512_set1_ps(-e[2][Z]), yB2 = _mm512_set1_ps(e[2][X]);
+    const __m512 yR0 = _mm512_set1_ps(fe[0][Z] * h[X] + fe[0][X] * h[Z]);
+    const __m512 yR1 = _mm512_set1_ps(fe[1][Z] * h[X] + fe[1][X] * h[Z]);
+    const __m512 yR2 = _mm512_set1_ps(fe[2][Z] * h[X] + fe[2][X] * h[Z]);
+
+    // Z-tests: p = a*v[X] - b*v[Y].
+    const __m512 zA0 = _mm512_set1_ps(e[0][Y]), zB0 = _mm512_set1_ps(e[0][X]);
+    const __m512 zA1 = _mm512_set1_ps(e[1][Y]), zB1 = _mm512_set1_ps(e[1][X]);
+    const __m512 zA2 = _mm512_set1_ps(e[2][Y]), zB2 = _mm512_set1_ps(e[2][X]);
+    const __m512 zR0 = _mm512_set1_ps(fe[0][Y] * h[X] + fe[0][X] * h[Y]);
+    const __m512 zR1 = _mm512_set1_ps(fe[1][Y] * h[X] + fe[1][X] * h[Y]);
+    const __m512 zR2 = _mm512_set1_ps(fe[2][Y] * h[X] + fe[2][X] * h[Y]);
+
+    const __m512 V0x = _mm512_set1_ps(tri.V[0][X]);
+    const __m512 V1x = _mm512_set1_ps(tri.V[1][X]);
+    const __m512 V2x = _mm512_set1_ps(tri.V[2][X]);
+    const __m512 v0Z = _mm512_set1_ps(v0z), v1Z = _mm512_set1_ps(v1z), v2Z = _mm512_set1_ps(v2z);
+    const __m512 v0Y = _mm512_set1_ps(v0y), v1Y = _mm512_set1_ps(v1y), v2Y = _mm512_set1_ps(v2y);
+
+    unsigned long long mask = 0;
+    for (int i = 0; i < count; i += 16) {
+        __m512 cx = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_add_epi32(_mm512_set1_epi32(x + i), lanes)), delta);
+        __m512 v0x = _mm512_sub_ps(V0x, cx);
+        __m512 v1x = _mm512_sub_ps(V1x, cx);
+        __m512 v2x = _mm512_sub_ps(V2x, cx);
+        __mmask16 inside = 0xffff;
+        __m512 p0, p1, p2;
+
+        // AXISTEST_Y02(e0[Z], e0[X], fe0[Z], fe0[X])
+        p0 = _mm512_add_ps(_mm512_mul_ps(yA0, v0x), _mm512_mul_ps(yB0, v0Z));
+        p2 = _mm512_add_ps(_mm512_mul_ps(yA0, v2x), _mm512_mul_ps(yB0, v2Z));
+        AXISTEST(p0, p2, yR0);
+
+        // AXISTEST_Z12(e0[Y], e0[X], fe0[Y], fe0[X])
+        p1 = _mm512_sub_ps(_mm512_mul_ps(zA0, v1x), _mm512_mul_ps(zB0, v1Y));
+        p2 = _mm512_sub_ps(_mm512_mul_ps(zA0, v2x), _mm512_mul_ps(zB0, v2Y));
+        AXISTEST(p1, p2, zR0);
+
+        // AXISTEST_Y02(e1[Z], e1[X], fe1[Z], fe1[X])
+        p0 = _mm512_add_ps(_mm512_mul_ps(yA1, v0x), _mm512_mul_ps(yB1, v0Z));
+        p2 = _mm512_add_ps(_mm512_mul_ps(yA1, v2x), _mm512_mul_ps(yB1, v2Z));
+        AXISTEST(p0, p2, yR1);
+
+        // AXISTEST_Z0(e1[Y], e1[X], fe1[Y], fe1[X])
+        p0 = _mm512_sub_ps(_mm512_mul_ps(zA1, v0x), _mm512_mul_ps(zB1, v0Y));
+        p1 = _mm512_sub_ps(_mm512_mul_ps(zA1, v1x), _mm512_mul_ps(zB1, v1Y));
+        AXISTEST(p0, p1, zR1);
+
+        // AXISTEST_Y1(e2[Z], e2[X], fe2[Z], fe2[X])
+        p0 = _mm512_add_ps(_mm512_mul_ps(yA2, v0x), _mm512_mul_ps(yB2, v0Z));
+        p1 = _mm512_add_ps(_mm512_mul_ps(yA2, v1x), _mm512_mul_ps(yB2, v1Z));
+        AXISTEST(p0, p1, yR2);
+
+        // AXISTEST_Z12(e2[Y], e2[X], fe2[Y], fe2[X])
+        p1 = _mm512_sub_ps(_mm512_mul_ps(zA2, v1x), _mm512_mul_ps(zB2, v1Y));
+        p2 = _mm512_sub_ps(_mm512_mul_ps(zA2, v2x), _mm512_mul_ps(zB2, v2Y));
+        AXISTEST(p1, p2, zR2);
+
+        mask |= (unsigned long long) inside << i;
+    }
+
+    // The last step may have tested voxels past the end of the span.
+    return count < 64 ? mask & ((1ull << count) - 1) : mask;
+}
+
+} // namespace OpenVOX
+
+#endif
@@ -0,0 +1,63 @@
+#include "Common.hpp"
+
+namespace OpenVOX {
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+
+bool CpuSupports(int simdWidth)
+{
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave)
+        return false;
+
+    unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    if (simdWidth == 8)
+        return (xcr0 & 0x6) == 0x6 && (info[1] & (1 << 5)) != 0;
+    return (xcr0 & 0xe6) == 0xe6 && (info[1] & (1 << 16)) != 0;
+}
+
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+bool CpuSupports(int simdWidth)
+{
+    __builtin_cpu_init();
+    return simdWidth == 8 ? __builtin_cpu_supports("avx2") != 0 : __builtin_cpu_supports("avx512f") != 0;
+}
+
+#else
+
+bool CpuSupports(int)
+{
+    return false;
+}
+
+#endif
+
+// Picks the widest row test that was compiled in and that this processor can run,
+// without exceeding the requested width.  A width of zero means "as wide as possible".
+RowTestFunc ChooseRowTest(VOXuint simdWidth)
+{
+    if (simdWidth == 0)
+        simdWidth = 16;
+
+#ifdef OPENVOX_HAVE_AVX512
+    if (simdWidth >= 16 && CpuSupports(16))
+        return TestRowAvx512;
+#endif
+
+#ifdef OPENVOX_HAVE_AVX2
+    if (simdWidth >= 8 && CpuSupports(8))
+        return TestRowAvx2;
+#endif
+
+    return TestRowScalar;
+}
+
+} // namespace OpenVOX
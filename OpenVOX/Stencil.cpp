@@ -0,0 +1,298 @@
+#include "Common.hpp"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define STENCIL_SSE
+#endif
+
+namespace OpenVOX {
+
+// Central-difference stencils: gradients of scalar volumes and curls of vector ones, in
+// voxel units, one-sided on the faces of the volume.
+//
+// The volume is cut into tiles whose source, plus a one-voxel halo, fits comfortably in L2,
+// and the threads take a tile at a time.  A tile is read once through ReadVoxelSpan, which
+// copes with every storage kind, into float planes, one per component and x-fastest, so that
+// four neighbouring voxels along a row are one SSE register for every tap of the stencil.
+// The halo past the faces of the volume repeats the face, which turns the central difference
+// there into half the one-sided one; the scales below make up for it.
+
+static const int TileWidth = 64;
+static const int TileHeight = 16;
+static const size_t TileBytes = 192 * 1024;
+
+enum StencilOutput {
+    OutputMagnitude,    // FLOAT32: the length of the gradient or curl
+    OutputVector,       // FLOAT32X4: the gradient or curl, and its length in w
+    OutputNormal,       // FLOAT32X4: the unit vector against the gradient, and its length in w
+};
+
+struct TilePod {
+    int Origin[3];
+    int Extent[3];
+    int Pitch;          // floats per row of a plane, halo included
+    int SlicePitch;
+    size_t PlaneSize;
+    std::vector<float> Data;
+    const float* At(int plane, int x, int y, int z) const { return &Data[plane * PlaneSize + (z + 1) * SlicePitch + (y + 1) * Pitch + x + 1]; }
+    float* At(int plane, int x, int y, int z) { return &Data[plane * PlaneSize + (z + 1) * SlicePitch + (y + 1) * Pitch + x + 1]; }
+};
+
+// The rows a stencil reads around one row of a plane.
+struct RowTaps {
+    const float* C;
+    const float* YM;
+    const float* YP;
+    const float* ZM;
+    const float* ZP;
+};
+
+static RowTaps GetTaps(const TilePod& tile, int plane, int y, int z)
+{
+    RowTaps taps = { tile.At(plane, 0, y, z), tile.At(plane, 0, y - 1, z), tile.At(plane, 0, y + 1, z),
+                     tile.At(plane, 0, y, z - 1), tile.At(plane, 0, y, z + 1) };
+    return taps;
+}
+
+// Converts count voxels of a row as ReadVoxelSpan leaves them into floats, one plane per
+// component; vector volumes keep their xyz.
+static void ConvertSpan(const unsigned char* src, int count, VOXenum type, float* planes[3])
+{
+    switch (type)
+    {
+        case VOX_TYPE_BIT:
+        case VOX_TYPE_UINT8: for (int i = 0; i < count; ++i) planes[0][i] = src[i]; break;
+        case VOX_TYPE_UINT16: for (int i = 0; i < count; ++i) planes[0][i] = ((const VOXushort*) src)[i]; break;
+        case VOX_TYPE_UINT32: for (int i = 0; i < count; ++i) planes[0][i] = (float) ((const VOXuint*) src)[i]; break;
+        case VOX_TYPE_FLOAT32: memcpy(planes[0], src, count * sizeof(float)); break;
+        case VOX_TYPE_FLOAT32X4:
+            for (int i = 0; i < count; ++i) {
+                const float* v = (const float*) src + i * 4;
+                planes[0][i] = v[0];
+                planes[1][i] = v[1];
+                planes[2][i] = v[2];
+            }
+            break;
+        default: break;
+    }
+}
+
+static void LoadTile(const VolumePod* src, int planeCount, TilePod& tile, std::vector<unsigned char>& span)
+{
+    const int width = src->Width, height = src->Height, depth = src->Depth;
+    const int x0 = tile.Origin[0], w = tile.Extent[0];
+    const int first = std::max(x0 - 1, 0), last = std::min(x0 + w + 1, width);
+    const VOXuint bytesPerVoxel = src->BytesPerVoxel ? src->BytesPerVoxel : 1;
+    span.resize((size_t) (last - first) * bytesPerVoxel);
+
+    for (int z = -1; z <= tile.Extent[2]; ++z)
+        for (int y = -1; y <= tile.Extent[1]; ++y) {
+            int sy = std::min(std::max(tile.Origin[1] + y, 0), height - 1);
+            int sz = std::min(std::max(tile.Origin[2] + z, 0), depth - 1);
+            ReadVoxelSpan(src, first, sy, sz, last - first, &span[0]);
+
+            float* planes[3] = { 0, 0, 0 };
+            for (int p = 0; p < planeCount; ++p)
+                planes[p] = tile.At(p, first - x0, y, z);
+            ConvertSpan(&span[0], last - first, src->Type, planes);
+            for (int p = 0; p < planeCount; ++p) {
+                float* row = tile.At(p, 0, y, z);
+                if (x0 == 0)
+                    row[-1] = row[0];
+                if (x0 + w == width)
+                    row[w] = row[w - 1];
+            }
+        }
+}
+
+static inline void StoreVoxel(float x, float y, float z, StencilOutput output, float* out)
+{
+    float length = sqrtf(x * x + y * y + z * z);
+    if (output == OutputMagnitude) {
+        *out = length;
+        return;
+    }
+    if (output == OutputNormal) {
+        float scale = length > 0 ? -1.0f / length : 0.0f;
+        x *= scale;
+        y *= scale;
+        z *= scale;
+    }
+    out[0] = x;
+    out[1] = y;
+    out[2] = z;
+    out[3] = length;
+}
+
+static void GradientVoxel(const RowTaps& f, int i, const float scale[3], StencilOutput output, float* out)
+{
+    StoreVoxel((f.C[i + 1] - f.C[i - 1]) * scale[0], (f.YP[i] - f.YM[i]) * scale[1], (f.ZP[i] - f.ZM[i]) * scale[2],
+               output, output == OutputMagnitude ? out + i : out + i * 4);
+}
+
+// Curl of (u, v, w): (dw/dy - dv/dz, du/dz - dw/dx, dv/dx - du/dy).
+static void CurlVoxel(const RowTaps* f, int i, const float scale[3], StencilOutput output, float* out)
+{
+    const RowTaps &u = f[0], &v = f[1], &w = f[2];
+    float dvdx = (v.C[i + 1] - v.C[i - 1]) * scale[0], dwdx = (w.C[i + 1] - w.C[i - 1]) * scale[0];
+    float dudy = (u.YP[i] - u.YM[i]) * scale[1], dwdy = (w.YP[i] - w.YM[i]) * scale[1];
+    float dudz = (u.ZP[i] - u.ZM[i]) * scale[2], dvdz = (v.ZP[i] - v.ZM[i]) * scale[2];
+    StoreVoxel(dwdy - dvdz, dudz - dwdx, dvdx - dudy, output, output == OutputMagnitude ? out + i : out + i * 4);
+}
+
+#ifdef STENCIL_SSE
+
+static inline void StoreVoxels(__m128 x, __m128 y, __m128 z, StencilOutput output, float* out)
+{
+    __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+    if (output == OutputMagnitude) {
+        _mm_storeu_ps(out, length);
+        return;
+    }
+    if (output == OutputNormal) {
+        __m128 scale = _mm_and_ps(_mm_cmpgt_ps(length, _mm_setzero_ps()), _mm_div_ps(_mm_set1_ps(-1.0f), length));
+        x = _mm_mul_ps(x, scale);
+        y = _mm_mul_ps(y, scale);
+        z = _mm_mul_ps(z, scale);
+    }
+    __m128 w = length;
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+    _mm_storeu_ps(out, x);
+    _mm_storeu_ps(out + 4, y);
+    _mm_storeu_ps(out + 8, z);
+    _mm_storeu_ps(out + 12, w);
+}
+
+static inline __m128 DeltaX(const RowTaps& f, int i, __m128 scale)
+{
+    return _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(f.C + i + 1), _mm_loadu_ps(f.C + i - 1)), scale);
+}
+
+static inline __m128 DeltaY(const RowTaps& f, int i, __m128 scale)
+{
+    return _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(f.YP + i), _mm_loadu_ps(f.YM + i)), scale);
+}
+
+static inline __m128 DeltaZ(const RowTaps& f, int i, __m128 scale)
+{
+    return _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(f.ZP + i), _mm_loadu_ps(f.ZM + i)), scale);
+}
+
+#endif
+
+// One row of the tile, n voxels; scale holds the interior x scale and the row's y and z ones.
+static void GradientRow(const RowTaps& f, int n, const float scale[3], StencilOutput output, float* out)
+{
+    int i = 0;
+#ifdef STENCIL_SSE
+    const __m128 sx = _mm_set1_ps(scale[0]), sy = _mm_set1_ps(scale[1]), sz = _mm_set1_ps(scale[2]);
+    const int stride = output == OutputMagnitude ? 1 : 4;
+    for (; i + 4 <= n; i += 4)
+        StoreVoxels(DeltaX(f, i, sx), DeltaY(f, i, sy), DeltaZ(f, i, sz), output, out + i * stride);
+#endif
+    for (; i < n; ++i)
+        GradientVoxel(f, i, scale, output, out);
+}
+
+static void CurlRow(const RowTaps* f, int n, const float scale[3], StencilOutput output, float* out)
+{
+    int i = 0;
+#ifdef STENCIL_SSE
+    const __m128 sx = _mm_set1_ps(scale[0]), sy = _mm_set1_ps(scale[1]), sz = _mm_set1_ps(scale[2]);
+    const int stride = output == OutputMagnitude ? 1 : 4;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x = _mm_sub_ps(DeltaY(f[2], i, sy), DeltaZ(f[1], i, sz));
+        __m128 y = _mm_sub_ps(DeltaZ(f[0], i, sz), DeltaX(f[2], i, sx));
+        __m128 z = _mm_sub_ps(DeltaX(f[1], i, sx), DeltaY(f[0], i, sy));
+        StoreVoxels(x, y, z, output, out + i * stride);
+    }
+#endif
+    for (; i < n; ++i)
+        CurlVoxel(f, i, scale, output, out);
+}
+
+// Scale of the difference across a voxel: half inside, whole on a face, where the halo
+// repeats the voxel itself.
+static inline float FaceScale(int i, int extent)
+{
+    return i > 0 && i < extent - 1 ? 0.5f : 1.0f;
+}
+
+void TransformStencil(VolumePod* dest, const VolumePod* src, VOXenum op)
+{
+    const bool curl = op == VOX_TRANSFORM_CURL;
+    if (dest == src || (dest->Type != VOX_TYPE_FLOAT32 && dest->Type != VOX_TYPE_FLOAT32X4) || dest->Hash || dest->Octree) {
+        ReportError(dest->Context, "voxTransform: stencils need a separate dense or sparse VOX_TYPE_FLOAT32 or VOX_TYPE_FLOAT32X4 destination.\n");
+        return;
+    }
+    if (curl != (src->Type == VOX_TYPE_FLOAT32X4)) {
+        ReportError(dest->Context, curl ? "voxTransform: curls need a VOX_TYPE_FLOAT32X4 source.\n" : "voxTransform: gradients need a scalar source.\n");
+        return;
+    }
+    if (op == VOX_TRANSFORM_GRADIENT_NORMALS && dest->Type != VOX_TYPE_FLOAT32X4) {
+        ReportError(dest->Context, "voxTransform: normals need a VOX_TYPE_FLOAT32X4 destination.\n");
+        return;
+    }
+
+    const StencilOutput output = dest->Type == VOX_TYPE_FLOAT32 ? OutputMagnitude : op == VOX_TRANSFORM_GRADIENT_NORMALS ? OutputNormal : OutputVector;
+    const int planeCount = curl ? 3 : 1;
+    const int width = src->Width, height = src->Height, depth = src->Depth;
+
+    // As deep as the budget allows, given the tile's other two sides.
+    const size_t sliceBytes = (size_t) (TileWidth + 2) * (TileHeight + 2) * planeCount * sizeof(float);
+    const int tileDepth = std::max((int) (TileBytes / sliceBytes) - 2, 1);
+    const int tiles[3] = { (width + TileWidth - 1) / TileWidth, (height + TileHeight - 1) / TileHeight, (depth + tileDepth - 1) / tileDepth };
+
+    DetachSources(dest);
+    ParallelFor(dest->Context->Pool, (size_t) tiles[0] * tiles[1] * tiles[2], 1,
+        [&](size_t begin, size_t end, unsigned int) {
+            TilePod tile;
+            tile.Pitch = TileWidth + 2;
+            tile.SlicePitch = tile.Pitch * (TileHeight + 2);
+            tile.PlaneSize = (size_t) tile.SlicePitch * (tileDepth + 2);
+            tile.Data.resize(tile.PlaneSize * planeCount);
+            std::vector<unsigned char> span;
+            std::vector<float> out((size_t) TileWidth * 4);
+
+            for (size_t t = begin; t < end; ++t) {
+                tile.Origin[0] = (int) (t % tiles[0]) * TileWidth;
+                tile.Origin[1] = (int) (t / tiles[0] % tiles[1]) * TileHeight;
+                tile.Origin[2] = (int) (t / tiles[0] / tiles[1]) * tileDepth;
+                tile.Extent[0] = std::min(TileWidth, width - tile.Origin[0]);
+                tile.Extent[1] = std::min(TileHeight, height - tile.Origin[1]);
+                tile.Extent[2] = std::min(tileDepth, depth - tile.Origin[2]);
+                LoadTile(src, planeCount, tile, span);
+
+                const int n = tile.Extent[0];
+                for (int z = 0; z < tile.Extent[2]; ++z)
+                    for (int y = 0; y < tile.Extent[1]; ++y) {
+                        RowTaps taps[3];
+                        for (int p = 0; p < planeCount; ++p)
+                            taps[p] = GetTaps(tile, p, y, z);
+                        float scale[3] = { 0.5f, FaceScale(tile.Origin[1] + y, height), FaceScale(tile.Origin[2] + z, depth) };
+                        if (curl)
+                            CurlRow(taps, n, scale, output, &out[0]);
+                        else
+                            GradientRow(taps[0], n, scale, output, &out[0]);
+
+                        // The faces at either end of the row take the one-sided difference.
+                        for (int i = 0; i < n; i += std::max(n - 1, 1)) {
+                            int x = tile.Origin[0] + i;
+                            if (x > 0 && x < width - 1)
+                                continue;
+                            scale[0] = 1.0f;
+                            if (curl)
+                                CurlVoxel(taps, i, scale, output, &out[0]);
+                            else
+                                GradientVoxel(taps[0], i, scale, output, &out[0]);
+                        }
+                        WriteVoxelSpan(dest, tile.Origin[0], tile.Origin[1] + y, tile.Origin[2] + z, n, (const unsigned char*) &out[0]);
+                    }
+            }
+        });
+}
+
+} // namespace OpenVOX
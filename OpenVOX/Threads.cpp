@@ -0,0 +1,135 @@
+#include "Common.hpp"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace OpenVOX {
+
+// Persistent workers that sleep between batches, so that per-frame voxelization
+// does not pay for thread creation.  The calling thread takes part in every batch.
+struct ThreadPool {
+    std::vector<std::thread> Workers;
+    std::mutex Mutex;
+    std::condition_variable WakeCondition;
+    std::condition_variable DoneCondition;
+    const std::function<void(size_t, size_t, unsigned int)>* Body;
+    std::atomic<size_t> NextJob;
+    size_t JobCount;
+    size_t Grain;
+    size_t Count;
+    unsigned int Generation;
+    unsigned int BusyWorkers;
+    bool Quit;
+};
+
+static void RunJobs(ThreadPool* pool, unsigned int thread)
+{
+    for (;;) {
+        size_t job = pool->NextJob.fetch_add(1);
+        if (job >= pool->JobCount)
+            break;
+        size_t begin = job * pool->Grain;
+        size_t end = begin + pool->Grain < pool->Count ? begin + pool->Grain : pool->Count;
+        (*pool->Body)(begin, end, thread);
+    }
+}
+
+static void WorkerMain(ThreadPool* pool, unsigned int thread)
+{
+    unsigned int generation = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(pool->Mutex);
+            while (!pool->Quit && pool->Generation == generation)
+                pool->WakeCondition.wait(lock);
+            if (pool->Quit)
+                return;
+            generation = pool->Generation;
+        }
+
+        RunJobs(pool, thread);
+
+        std::unique_lock<std::mutex> lock(pool->Mutex);
+        if (--pool->BusyWorkers == 0)
+            pool->DoneCondition.notify_one();
+    }
+}
+
+ThreadPool* CreateThreadPool(unsigned int threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0)
+        threadCount = 1;
+
+    ThreadPool* pool = new ThreadPool;
+    pool->Body = 0;
+    pool->NextJob = 0;
+    pool->JobCount = 0;
+    pool->Grain = 1;
+    pool->Count = 0;
+    pool->Generation = 0;
+    pool->BusyWorkers = 0;
+    pool->Quit = false;
+
+    // Thread zero is whoever calls ParallelFor.
+    for (unsigned int thread = 1; thread < threadCount; ++thread)
+        pool->Workers.push_back(std::thread(WorkerMain, pool, thread));
+
+    return pool;
+}
+
+void DestroyThreadPool(ThreadPool* pool)
+{
+    {
+        std::unique_lock<std::mutex> lock(pool->Mutex);
+        pool->Quit = true;
+        pool->WakeCondition.notify_all();
+    }
+    for (size_t i = 0; i < pool->Workers.size(); ++i)
+        pool->Workers[i].join();
+    delete pool;
+}
+
+unsigned int GetThreadCount(ThreadPool* pool)
+{
+    return (unsigned int) pool->Workers.size() + 1;
+}
+
+void ParallelFor(ThreadPool* pool, size_t count, size_t grain,
+                 const std::function<void(size_t begin, size_t end, unsigned int thread)>& body)
+{
+    if (count == 0)
+        return;
+
+    if (grain == 0)
+        grain = 1;
+
+    size_t jobCount = (count + grain - 1) / grain;
+    if (jobCount == 1 || pool->Workers.empty()) {
+        for (size_t begin = 0; begin < count; begin += grain)
+            body(begin, begin + grain < count ? begin + grain : count, 0);
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(pool->Mutex);
+        pool->Body = &body;
+        pool->Count = count;
+        pool->Grain = grain;
+        pool->JobCount = jobCount;
+        pool->NextJob = 0;
+        pool->BusyWorkers = (unsigned int) pool->Workers.size();
+        pool->Generation++;
+        pool->WakeCondition.notify_all();
+    }
+
+    RunJobs(pool, 0);
+
+    std::unique_lock<std::mutex> lock(pool->Mutex);
+    while (pool->BusyWorkers != 0)
+        pool->DoneCondition.wait(lock);
+}
+
+} // namespace OpenVOX
@@ -0,0 +1,31 @@
+#include "Common.hpp"
+
+using namespace OpenVOX;
+
+void voxTransform(VOXhandle destVolume, VOXhandle srcVolume, VOXenum transformOp)
+{
+    VolumePod* dest = CastHandle<VolumePod>(destVolume, HandleVolume);
+    VolumePod* src = CastHandle<VolumePod>(srcVolume, HandleVolume);
+    if (!dest || !src) {
+        ReportError(0, "voxTransform: invalid volume handle.\n");
+        return;
+    }
+
+    if (dest->Width != src->Width || dest->Height != src->Height || dest->Depth != src->Depth) {
+        ReportError(dest->Context, "voxTransform: volumes must have matching dimensions.\n");
+        return;
+    }
+
+    switch (transformOp)
+    {
+        case VOX_TRANSFORM_DISTANCE_EUCLIDEAN:
+        case VOX_TRANSFORM_DISTANCE_SQR_EUCLIDEAN:
+        case VOX_TRANSFORM_DISTANCE_MANHATTAN: TransformDistance(dest, src, transformOp); break;
+        case VOX_TRANSFORM_DISTANCE_NARROW_BAND: TransformNarrowBand(dest, src); break;
+        case VOX_TRANSFORM_GRADIENT:
+        case VOX_TRANSFORM_GRADIENT_NORMALS:
+        case VOX_TRANSFORM_CURL: TransformStencil(dest, src, transformOp); break;
+        case VOX_TRANSFORM_FLUID_ADVECT: TransformAdvect(dest, src); break;
+        default: ReportError(dest->Context, "voxTransform: unsupported operation 0x%4.4x.\n", transformOp);
+    }
+}
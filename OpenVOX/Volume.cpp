@@ -0,0 +1,678 @@
+#include "Common.hpp"
+#include <stdlib.h>
+#include <string.h>
+
+using namespace OpenVOX;
+
+namespace OpenVOX {
+
+VOXuint GetBytesPerVoxel(VOXenum type)
+{
+    switch (type)
+    {
+        case VOX_TYPE_UINT32: return 4;
+        case VOX_TYPE_UINT16: return 2;
+        case VOX_TYPE_UINT8:  return 1;
+        case VOX_TYPE_FLOAT32: return 4;
+        case VOX_TYPE_FLOAT32X4: return 16;
+        default: return 0;
+    }
+}
+
+} // namespace OpenVOX
+
+VOXhandle voxCreateVolume(
+    VOXhandle context,
+    VOXuint width,
+    VOXuint height,
+    VOXuint depth,
+    VOXenum type,
+    VOXenum sourceFlags,
+    void* sourceData)
+{
+    ContextPod* contextPod = CastHandle<ContextPod>(context, HandleContext);
+    if (!contextPod) {
+        ReportError(0, "voxCreateVolume: invalid context handle.\n");
+        return 0;
+    }
+
+    VOXuint bytesPerVoxel = GetBytesPerVoxel(type);
+    if (!bytesPerVoxel && type != VOX_TYPE_BIT) {
+        ReportError(contextPod, "voxCreateVolume: unsupported voxel type 0x%4.4x.\n", type);
+        return 0;
+    }
+
+    if (!width || !height || !depth) {
+        ReportError(contextPod, "voxCreateVolume: volumes cannot be empty.\n");
+        return 0;
+    }
+
+    VOXenum storage = GetParams().VolumeStorage;
+    if (storage != VOX_STORAGE_SPARSE && storage != VOX_STORAGE_HASH && storage != VOX_STORAGE_OCTREE)
+        storage = VOX_STORAGE_DENSE;
+    if (storage != VOX_STORAGE_DENSE && SourceMode(sourceFlags) == SourceMode(VOX_SOURCE_USE_PTR)) {
+        ReportError(contextPod, "voxCreateVolume: only dense volumes can use VOX_SOURCE_USE_PTR.\n");
+        return 0;
+    }
+    if (storage != VOX_STORAGE_DENSE && type == VOX_TYPE_BIT) {
+        ReportError(contextPod, "voxCreateVolume: only dense volumes can hold VOX_TYPE_BIT.\n");
+        return 0;
+    }
+    if ((storage == VOX_STORAGE_HASH || storage == VOX_STORAGE_OCTREE) &&
+        (width > 1u << KeyAxisBits || height > 1u << KeyAxisBits || depth > 1u << KeyAxisBits)) {
+        ReportError(contextPod, "voxCreateVolume: hash and octree volumes are limited to %u voxels per axis.\n", 1u << KeyAxisBits);
+        return 0;
+    }
+    if (storage == VOX_STORAGE_OCTREE && sourceFlags != VOX_SOURCE_IGNORE_PTR) {
+        ReportError(contextPod, "voxCreateVolume: octree volumes start empty and are filled by voxVoxelize.\n");
+        return 0;
+    }
+
+    VOXenum layout = storage == VOX_STORAGE_DENSE && GetParams().VolumeLayout == VOX_LAYOUT_TILED ? VOX_LAYOUT_TILED : VOX_LAYOUT_LINEAR;
+    if (layout == VOX_LAYOUT_TILED && type == VOX_TYPE_BIT) {
+        ReportError(contextPod, "voxCreateVolume: VOX_TYPE_BIT volumes are always linear.\n");
+        return 0;
+    }
+    if (layout == VOX_LAYOUT_TILED && SourceMode(sourceFlags) == SourceMode(VOX_SOURCE_USE_PTR)) {
+        ReportError(contextPod, "voxCreateVolume: tiled volumes cannot use VOX_SOURCE_USE_PTR.\n");
+        return 0;
+    }
+
+    VolumePod* volume = new VolumePod;
+    volume->Kind = HandleVolume;
+    volume->Context = contextPod;
+    volume->Width = width;
+    volume->Height = height;
+    volume->Depth = depth;
+    volume->Type = type;
+    volume->BytesPerVoxel = bytesPerVoxel;
+    volume->RowPitch = type == VOX_TYPE_BIT ? BitRowWords(width) * sizeof(VOXuint64) : (size_t) width * bytesPerVoxel;
+    volume->SlicePitch = volume->RowPitch * height;
+    volume->ByteCount = volume->SlicePitch * depth;
+    volume->Layout = layout;
+    if (layout == VOX_LAYOUT_TILED)
+        volume->ByteCount = (size_t) BrickCount(width) * BrickCount(height) * BrickCount(depth) * BrickVoxels * bytesPerVoxel;
+    volume->Data = 0;
+    volume->OwnsData = false;
+    volume->Storage = storage;
+    volume->Bricks = 0;
+    volume->Hash = 0;
+    volume->Octree = 0;
+    volume->FillValue = 0;
+
+    if (storage != VOX_STORAGE_DENSE) {
+        if (storage == VOX_STORAGE_SPARSE)
+            volume->Bricks = CreateBrickIndex(volume);
+        else if (storage == VOX_STORAGE_HASH)
+            volume->Hash = CreateVoxelHash();
+        else
+            volume->Octree = CreateOctree(volume);
+        if (sourceFlags != VOX_SOURCE_IGNORE_PTR)
+            voxUpdateVolume(volume, sourceFlags, sourceData);
+        return volume;
+    }
+
+    if (SourceMode(sourceFlags) == SourceMode(VOX_SOURCE_USE_PTR)) {
+        if (SourceKind(sourceFlags) != SourceKind(VOX_SOURCE_USE_PTR) || !sourceData) {
+            ReportError(contextPod, "voxCreateVolume: VOX_SOURCE_USE_PTR requires a CPU pointer.\n");
+            delete volume;
+            return 0;
+        }
+        volume->Data = (unsigned char*) sourceData;
+        return volume;
+    }
+
+    volume->Data = (unsigned char*) calloc(volume->ByteCount, 1);
+    volume->OwnsData = true;
+    if (!volume->Data) {
+        ReportError(contextPod, "voxCreateVolume: out of memory.\n");
+        delete volume;
+        return 0;
+    }
+
+    if (sourceFlags != VOX_SOURCE_IGNORE_PTR)
+        voxUpdateVolume(volume, sourceFlags, sourceData);
+
+    return volume;
+}
+
+// Adds the non-zero voxels of a row to a hash volume.  Cheaper than WriteVoxelSpan when
+// the table is known to be empty, since the zero voxels need no removal.
+static void InsertNonZero(VolumePod* volume, int y, int z, const unsigned char* row, VOXuint bytesPerVoxel)
+{
+    static const unsigned char zero[16] = { 0 };
+    for (VOXuint x = 0; x < volume->Width; ++x, row += bytesPerVoxel)
+        if (memcmp(row, zero, bytesPerVoxel))
+            InsertVoxel(volume->Hash, x, y, z);
+}
+
+static VOXuint64 CountNonZero(const unsigned char* data, size_t count, VOXuint bytesPerVoxel)
+{
+    VOXuint64 n = 0;
+    switch (bytesPerVoxel)
+    {
+        case 1: for (size_t i = 0; i < count; ++i) n += data[i] != 0; break;
+        case 2: { const VOXushort* p = (const VOXushort*) data; for (size_t i = 0; i < count; ++i) n += p[i] != 0; break; }
+        case 4: { const VOXuint* p = (const VOXuint*) data; for (size_t i = 0; i < count; ++i) n += p[i] != 0; break; }
+        case 16: { const VOXuint* p = (const VOXuint*) data; for (size_t i = 0; i < count; ++i, p += 4) n += (p[0] | p[1] | p[2] | p[3]) != 0; break; }
+    }
+    return n;
+}
+
+void voxUpdateVolume(
+    VOXhandle volume,
+    VOXenum sourceFlags,
+    void* sourceData)
+{
+    VolumePod* volumePod = CastHandle<VolumePod>(volume, HandleVolume);
+    if (!volumePod) {
+        ReportError(0, "voxUpdateVolume: invalid volume handle.\n");
+        return;
+    }
+
+    VOXenum kind = SourceKind(sourceFlags);
+    if (kind != VOX_SOURCE_CPU_MEMORY && kind != SourceKind(VOX_SOURCE_COPY_PTR)) {
+        ReportError(volumePod->Context, "voxUpdateVolume: the CPU backend only accepts CPU memory.\n");
+        return;
+    }
+
+    if (!sourceData || sourceData == volumePod->Data)
+        return;
+
+    if (volumePod->Octree) {
+        ReportError(volumePod->Context, "voxUpdateVolume: octree volumes are only written by voxVoxelize.\n");
+        return;
+    }
+
+    DetachSources(volumePod);
+
+    // Source data is linear with Z increasing, so each slice lands in its flipped position.
+    if (volumePod->Data && volumePod->Layout == VOX_LAYOUT_LINEAR) {
+        const unsigned char* pSrc = (const unsigned char*) sourceData;
+        for (VOXuint z = 0; z < volumePod->Depth; ++z, pSrc += volumePod->SlicePitch)
+            memcpy(volumePod->Data + VoxelOffset(volumePod, 0, 0, z), pSrc, volumePod->SlicePitch);
+        return;
+    }
+
+    if (volumePod->Hash) {
+        ClearVoxelHash(volumePod->Hash);
+        ReserveVoxelHash(volumePod->Hash, CountNonZero((const unsigned char*) sourceData,
+            (size_t) volumePod->Width * volumePod->Height * volumePod->Depth, volumePod->BytesPerVoxel));
+        RepeatOnOverflow(volumePod, [&]() {
+            const unsigned char* pSrc = (const unsigned char*) sourceData;
+            for (VOXuint z = 0; z < volumePod->Depth; ++z)
+                for (VOXuint y = 0; y < volumePod->Height; ++y, pSrc += volumePod->RowPitch)
+                    InsertNonZero(volumePod, y, z, pSrc, volumePod->BytesPerVoxel);
+        });
+        return;
+    }
+
+    RepeatOnOverflow(volumePod, [&]() {
+        const unsigned char* pSrc = (const unsigned char*) sourceData;
+        for (VOXuint z = 0; z < volumePod->Depth; ++z)
+            for (VOXuint y = 0; y < volumePod->Height; ++y, pSrc += volumePod->RowPitch)
+                WriteVoxelSpan(volumePod, 0, y, z, volumePod->Width, pSrc);
+    });
+}
+
+void voxReadVolume(
+    VOXhandle volume,
+    void* destData)
+{
+    VolumePod* volumePod = CastHandle<VolumePod>(volume, HandleVolume);
+    if (!volumePod) {
+        ReportError(0, "voxReadVolume: invalid volume handle.\n");
+        return;
+    }
+
+    unsigned char* pDest = (unsigned char*) destData;
+    if (volumePod->Data && volumePod->Layout == VOX_LAYOUT_LINEAR) {
+        for (VOXuint z = 0; z < volumePod->Depth; ++z, pDest += volumePod->SlicePitch)
+            memcpy(pDest, volumePod->Data + VoxelOffset(volumePod, 0, 0, z), volumePod->SlicePitch);
+        return;
+    }
+
+    if (volumePod->Data) {
+        for (VOXuint z = 0; z < volumePod->Depth; ++z)
+            for (VOXuint y = 0; y < volumePod->Height; ++y, pDest += volumePod->RowPitch)
+                ReadVoxelSpan(volumePod, 0, y, z, volumePod->Width, pDest);
+        return;
+    }
+
+    if (volumePod->Hash || volumePod->Octree) {
+        memset(pDest, 0, volumePod->ByteCount);
+        auto setVoxel = [&](int x, int y, int z) {
+            memset(pDest + x * volumePod->BytesPerVoxel + y * volumePod->RowPitch + z * volumePod->SlicePitch, 0xff, volumePod->BytesPerVoxel);
+        };
+        if (volumePod->Hash)
+            ForEachVoxel(volumePod->Hash, setVoxel);
+        else
+            ForEachOctreeVoxel(volumePod->Octree, setVoxel);
+        return;
+    }
+
+    // Untouched bricks read as the background, so fill first and then scatter the bricks.
+    FillVoxels(pDest, volumePod->ByteCount / volumePod->BytesPerVoxel, volumePod->BytesPerVoxel, GetBackground(volumePod));
+    ForEachBrick(volumePod, [&](int bx, int by, int bz, const unsigned char* brick) {
+        int x = bx * BrickSize;
+        int count = volumePod->Width - x < (VOXuint) BrickSize ? volumePod->Width - x : BrickSize;
+        for (int z = bz * BrickSize; z < bz * BrickSize + BrickSize && z < (int) volumePod->Depth; ++z)
+            for (int y = by * BrickSize; y < by * BrickSize + BrickSize && y < (int) volumePod->Height; ++y)
+                memcpy(pDest + x * volumePod->BytesPerVoxel + y * volumePod->RowPitch + z * volumePod->SlicePitch,
+                       brick + BrickVoxelOffset(volumePod, x, y, z), count * volumePod->BytesPerVoxel);
+    });
+}
+
+namespace OpenVOX {
+
+void FillVoxels(unsigned char* dest, size_t count, VOXuint bytesPerVoxel, VOXuint value)
+{
+    switch (bytesPerVoxel)
+    {
+        case 1: memset(dest, (int) (value & 0xff), count); break;
+        case 2: { VOXushort* p = (VOXushort*) dest; for (size_t i = 0; i < count; ++i) p[i] = (VOXushort) value; break; }
+        case 4: { VOXuint* p = (VOXuint*) dest; for (size_t i = 0; i < count; ++i) p[i] = value; break; }
+        case 16: { VOXuint* p = (VOXuint*) dest; for (size_t i = 0; i < count * 4; ++i) p[i] = value; break; }
+    }
+}
+
+// Bit volumes are filled with all-zero or all-one rows; the padding past the last voxel of
+// each row stays zero so that counting can simply popcount whole words.
+static void FillBits(VolumePod* volume, bool value)
+{
+    memset(volume->Data, 0, volume->ByteCount);
+    if (!value)
+        return;
+
+    size_t words = BitRowWords(volume->Width);
+    VOXuint64 last = volume->Width % 64 ? (1ull << (volume->Width % 64)) - 1 : ~0ull;
+    for (size_t offset = 0; offset < volume->ByteCount; offset += volume->RowPitch) {
+        VOXuint64* row = (VOXuint64*) (volume->Data + offset);
+        for (size_t w = 0; w + 1 < words; ++w)
+            row[w] = ~0ull;
+        row[words - 1] = last;
+    }
+}
+
+// Hash volumes have no background, so filling them with a non-zero value sets every voxel.
+static void FillHash(VolumePod* volume, bool value)
+{
+    ClearVoxelHash(volume->Hash);
+    if (!value)
+        return;
+
+    ReserveVoxelHash(volume->Hash, (size_t) volume->Width * volume->Height * volume->Depth);
+    RepeatOnOverflow(volume, [&]() {
+        for (VOXuint z = 0; z < volume->Depth; ++z)
+            for (VOXuint y = 0; y < volume->Height; ++y)
+                for (VOXuint x = 0; x < volume->Width; ++x)
+                    InsertVoxel(volume->Hash, x, y, z);
+    });
+}
+
+void FillVolume(VolumePod* volume, VOXuint value)
+{
+    volume->FillValue = value;
+    if (volume->Type == VOX_TYPE_BIT)
+        FillBits(volume, value != 0);
+    else if (volume->Bricks)
+        ClearBricks(volume, value);
+    else if (volume->Hash)
+        FillHash(volume, value != 0);
+    else if (volume->Octree && value)
+        ReportError(volume->Context, "voxGenerate: octree volumes can only be cleared to zero.\n");
+    else if (volume->Octree)
+        ClearOctree(volume->Octree);
+    else if (value == 0)
+        memset(volume->Data, 0, volume->ByteCount);
+    else
+        FillVoxels(volume->Data, volume->ByteCount / volume->BytesPerVoxel, volume->BytesPerVoxel, value);
+}
+
+void FillBrick(VolumePod* volume, int bx, int by, int bz, VOXuint value)
+{
+    unsigned char row[BrickSize * 16];
+    if (volume->Type == VOX_TYPE_BIT)
+        memset(row, value ? 0xff : 0, BrickSize);
+    else
+        FillVoxels(row, BrickSize, volume->BytesPerVoxel, value);
+
+    int x = bx * BrickSize;
+    int count = volume->Width - x < (VOXuint) BrickSize ? volume->Width - x : BrickSize;
+    for (int z = bz * BrickSize; z < bz * BrickSize + BrickSize && z < (int) volume->Depth; ++z)
+        for (int y = by * BrickSize; y < by * BrickSize + BrickSize && y < (int) volume->Height; ++y)
+            WriteVoxelSpan(volume, x, y, z, count, row);
+}
+
+// Reads count voxels of row (y, z) starting at x, whatever the storage.  Bit volumes are
+// expanded to one byte per voxel, 0 or 255.
+void ReadVoxelSpan(const VolumePod* volume, int x, int y, int z, int count, unsigned char* dest)
+{
+    const VOXuint bytesPerVoxel = volume->BytesPerVoxel;
+    if (volume->Type == VOX_TYPE_BIT) {
+        const VOXuint64* row = (const VOXuint64*) (volume->Data + VoxelOffset(volume, 0, y, z));
+        for (int i = 0; i < count; ++i, ++x)
+            dest[i] = (row[x >> 6] >> (x & 63)) & 1 ? 0xff : 0;
+        return;
+    }
+
+    if (volume->Hash || volume->Octree) {
+        for (int i = 0; i < count; ++i, ++x, dest += bytesPerVoxel) {
+            bool set = volume->Hash ? FindVoxel(volume->Hash, x, y, z) : FindOctreeVoxel(volume->Octree, x, y, z);
+            memset(dest, set ? 0xff : 0, bytesPerVoxel);
+        }
+        return;
+    }
+
+    if (volume->Layout == VOX_LAYOUT_TILED) {
+        for (int i = 0; i < count; ++i, ++x, dest += bytesPerVoxel)
+            memcpy(dest, volume->Data + VoxelOffset(volume, x, y, z), bytesPerVoxel);
+        return;
+    }
+
+    if (!volume->Bricks) {
+        memcpy(dest, volume->Data + VoxelOffset(volume, x, y, z), count * bytesPerVoxel);
+        return;
+    }
+
+    while (count > 0) {
+        int n = BrickSize - (x & (BrickSize - 1));
+        n = n < count ? n : count;
+        const unsigned char* brick = FindBrick(volume, x >> BrickShift, y >> BrickShift, z >> BrickShift);
+        if (brick)
+            memcpy(dest, brick + BrickVoxelOffset(volume, x, y, z), n * bytesPerVoxel);
+        else
+            FillVoxels(dest, n, bytesPerVoxel, GetBackground(volume));
+        x += n; count -= n; dest += n * bytesPerVoxel;
+    }
+}
+
+// Writes count voxels of row (y, z) starting at x.  Sparse volumes skip the parts of the
+// span that would only write the background into bricks that do not exist yet.  Bit
+// volumes take one byte per voxel and set the bits of the non-zero ones; hash volumes
+// likewise only record which voxels are non-zero.
+void WriteVoxelSpan(VolumePod* volume, int x, int y, int z, int count, const unsigned char* src)
+{
+    const VOXuint bytesPerVoxel = volume->BytesPerVoxel;
+    if (volume->Type == VOX_TYPE_BIT) {
+        VOXuint64* row = (VOXuint64*) (volume->Data + VoxelOffset(volume, 0, y, z));
+        for (int i = 0; i < count; ++i, ++x) {
+            VOXuint64 bit = 1ull << (x & 63);
+            row[x >> 6] = src[i] ? row[x >> 6] | bit : row[x >> 6] & ~bit;
+        }
+        return;
+    }
+
+    if (volume->Hash) {
+        static const unsigned char zero[16] = { 0 };
+        for (int i = 0; i < count; ++i, ++x, src += bytesPerVoxel) {
+            if (memcmp(src, zero, bytesPerVoxel))
+                InsertVoxel(volume->Hash, x, y, z);
+            else
+                RemoveVoxel(volume->Hash, x, y, z);
+        }
+        return;
+    }
+
+    if (volume->Layout == VOX_LAYOUT_TILED) {
+        for (int i = 0; i < count; ++i, ++x, src += bytesPerVoxel)
+            memcpy(volume->Data + VoxelOffset(volume, x, y, z), src, bytesPerVoxel);
+        return;
+    }
+
+    if (!volume->Bricks) {
+        memcpy(volume->Data + VoxelOffset(volume, x, y, z), src, count * bytesPerVoxel);
+        return;
+    }
+
+    unsigned char background[16];
+    FillVoxels(background, 1, bytesPerVoxel, GetBackground(volume));
+
+    while (count > 0) {
+        int n = BrickSize - (x & (BrickSize - 1));
+        n = n < count ? n : count;
+        unsigned char* brick = FindBrick(volume, x >> BrickShift, y >> BrickShift, z >> BrickShift);
+        for (int i = 0; !brick && i < n; ++i)
+            if (memcmp(src + i * bytesPerVoxel, background, bytesPerVoxel)) {
+                brick = TouchBrick(volume, x >> BrickShift, y >> BrickShift, z >> BrickShift);
+                break;
+            }
+        if (brick)
+            memcpy(brick + BrickVoxelOffset(volume, x, y, z), src, n * bytesPerVoxel);
+        x += n; count -= n; src += n * bytesPerVoxel;
+    }
+}
+
+} // namespace OpenVOX
+
+void voxGenerate(VOXhandle destVolume, VOXenum generateOp)
+{
+    VolumePod* volume = CastHandle<VolumePod>(destVolume, HandleVolume);
+    if (!volume) {
+        ReportError(0, "voxGenerate: invalid volume handle.\n");
+        return;
+    }
+
+    switch (generateOp)
+    {
+        case VOX_GENERATE_CLEAR: DetachSources(volume); FillVolume(volume, GetParams().ClearValue); break;
+        default: ReportError(volume->Context, "voxGenerate: unsupported operation 0x%4.4x.\n", generateOp);
+    }
+}
+
+static void CopyVoxels(VolumePod* dest, const VolumePod* src, bool convert)
+{
+    if (dest->Hash) {
+        const VOXuint bytesPerVoxel = src->BytesPerVoxel ? src->BytesPerVoxel : 1;
+        std::vector<unsigned char> row((size_t) src->Width * bytesPerVoxel);
+        ClearVoxelHash(dest->Hash);
+        for (VOXuint z = 0; z < src->Depth; ++z)
+            for (VOXuint y = 0; y < src->Height; ++y) {
+                ReadVoxelSpan(src, 0, y, z, src->Width, &row[0]);
+                InsertNonZero(dest, y, z, &row[0], bytesPerVoxel);
+            }
+        return;
+    }
+
+    if (convert) {
+        if (!dest->Data)
+            FillVolume(dest, 0);
+        std::vector<unsigned char> row(src->Width);
+        for (VOXuint z = 0; z < src->Depth; ++z)
+            for (VOXuint y = 0; y < src->Height; ++y) {
+                ReadVoxelSpan(src, 0, y, z, src->Width, &row[0]);
+                WriteVoxelSpan(dest, 0, y, z, src->Width, &row[0]);
+            }
+        return;
+    }
+
+    if (dest->Data && src->Data && dest->Layout == src->Layout) {
+        memcpy(dest->Data, src->Data, dest->ByteCount);
+        return;
+    }
+
+    if (src->Bricks) {
+        FillVolume(dest, GetBackground(src));
+        ForEachBrick(src, [&](int bx, int by, int bz, const unsigned char* brick) {
+            int x = bx * BrickSize;
+            int count = dest->Width - x < (VOXuint) BrickSize ? dest->Width - x : BrickSize;
+            for (int z = bz * BrickSize; z < bz * BrickSize + BrickSize && z < (int) dest->Depth; ++z)
+                for (int y = by * BrickSize; y < by * BrickSize + BrickSize && y < (int) dest->Height; ++y)
+                    WriteVoxelSpan(dest, x, y, z, count, brick + BrickVoxelOffset(src, x, y, z));
+        });
+        return;
+    }
+
+    FillVolume(dest, 0);
+    if (src->Hash || src->Octree) {
+        unsigned char ones[16];
+        memset(ones, 0xff, sizeof(ones));
+        auto setVoxel = [&](int x, int y, int z) { WriteVoxelSpan(dest, x, y, z, 1, ones); };
+        if (src->Hash)
+            ForEachVoxel(src->Hash, setVoxel);
+        else
+            ForEachOctreeVoxel(src->Octree, setVoxel);
+        return;
+    }
+
+    // Between linear and tiled layouts, one row at a time.
+    std::vector<unsigned char> row((size_t) src->Width * src->BytesPerVoxel);
+    for (VOXuint z = 0; z < src->Depth; ++z)
+        for (VOXuint y = 0; y < src->Height; ++y) {
+            ReadVoxelSpan(src, 0, y, z, src->Width, &row[0]);
+            WriteVoxelSpan(dest, 0, y, z, src->Width, &row[0]);
+        }
+}
+
+void voxCopy(VOXhandle destVolume, VOXhandle srcVolume)
+{
+    VolumePod* dest = CastHandle<VolumePod>(destVolume, HandleVolume);
+    VolumePod* src = CastHandle<VolumePod>(srcVolume, HandleVolume);
+    if (!dest || !src) {
+        ReportError(0, "voxCopy: invalid volume handle.\n");
+        return;
+    }
+
+    // Bit and byte volumes convert into each other; anything else needs matching types.
+    bool convert = dest->Type != src->Type &&
+        (dest->Type == VOX_TYPE_BIT || src->Type == VOX_TYPE_BIT) &&
+        (dest->Type == VOX_TYPE_UINT8 || src->Type == VOX_TYPE_UINT8);
+    if (dest->Width != src->Width || dest->Height != src->Height || dest->Depth != src->Depth || (dest->Type != src->Type && !convert)) {
+        ReportError(dest->Context, "voxCopy: volumes must have matching dimensions and types.\n");
+        return;
+    }
+
+    if (dest == src)
+        return;
+
+    if (dest->Octree) {
+        ReportError(dest->Context, "voxCopy: octree volumes are only written by voxVoxelize.\n");
+        return;
+    }
+
+    DetachSources(dest);
+    if (dest->Hash)
+        ReserveVoxelHash(dest->Hash, (size_t) voxCountVoxels(src));
+    RepeatOnOverflow(dest, [&]() { CopyVoxels(dest, src, convert); });
+}
+
+VOXuint64 voxCountVoxels(VOXhandle volume)
+{
+    VolumePod* volumePod = CastHandle<VolumePod>(volume, HandleVolume);
+    if (!volumePod) {
+        ReportError(0, "voxCountVoxels: invalid volume handle.\n");
+        return 0;
+    }
+
+    // Row padding is always zero, so bit volumes are a straight popcount.
+    if (volumePod->Type == VOX_TYPE_BIT) {
+        const VOXuint64* words = (const VOXuint64*) volumePod->Data;
+        VOXuint64 n = 0;
+        for (size_t i = 0; i < volumePod->ByteCount / sizeof(VOXuint64); ++i)
+            n += BitCount(words[i]);
+        return n;
+    }
+
+    if (volumePod->Hash)
+        return GetVoxelHashCount(volumePod->Hash);
+    if (volumePod->Octree)
+        return GetOctreeCount(volumePod->Octree);
+
+    size_t voxelCount = (size_t) volumePod->Width * volumePod->Height * volumePod->Depth;
+    if (volumePod->Layout == VOX_LAYOUT_TILED && volumePod->ByteCount != voxelCount * volumePod->BytesPerVoxel) {
+        // The tiles overhang the volume, and fills reach the overhang too, so skip it.
+        VOXuint64 n = 0;
+        for (VOXuint z = 0; z < volumePod->Depth; ++z)
+            for (VOXuint y = 0; y < volumePod->Height; ++y)
+                for (VOXuint x = 0; x < volumePod->Width; ++x)
+                    n += CountNonZero(volumePod->Data + VoxelOffset(volumePod, x, y, z), 1, volumePod->BytesPerVoxel);
+        return n;
+    }
+    if (!volumePod->Bricks)
+        return CountNonZero(volumePod->Data, voxelCount, volumePod->BytesPerVoxel);
+
+    // Sparse: every voxel outside the bricks is background; edge bricks are clipped.
+    VOXuint64 n = 0, covered = 0;
+    const VolumePod* v = volumePod;
+    ForEachBrick(v, [&](int bx, int by, int bz, const unsigned char* brick) {
+        int x = bx * BrickSize;
+        int count = v->Width - x < (VOXuint) BrickSize ? v->Width - x : BrickSize;
+        for (int z = bz * BrickSize; z < bz * BrickSize + BrickSize && z < (int) v->Depth; ++z)
+            for (int y = by * BrickSize; y < by * BrickSize + BrickSize && y < (int) v->Height; ++y) {
+                n += CountNonZero(brick + BrickVoxelOffset(v, x, y, z), count, v->BytesPerVoxel);
+                covered += count;
+            }
+    });
+    if (GetBackground(volumePod))
+        n += voxelCount - covered;
+    return n;
+}
+
+VOXbool voxLookupVoxel(VOXhandle volume, VOXuint x, VOXuint y, VOXuint z)
+{
+    VolumePod* volumePod = CastHandle<VolumePod>(volume, HandleVolume);
+    if (!volumePod) {
+        ReportError(0, "voxLookupVoxel: invalid volume handle.\n");
+        return VOX_FALSE;
+    }
+
+    if (x >= volumePod->Width || y >= volumePod->Height || z >= volumePod->Depth)
+        return VOX_FALSE;
+
+    static const unsigned char zero[16] = { 0 };
+    unsigned char voxel[16] = { 0 };
+    ReadVoxelSpan(volumePod, x, y, z, 1, voxel);
+    return memcmp(voxel, zero, sizeof(voxel)) ? VOX_TRUE : VOX_FALSE;
+}
+
+void voxIterateVoxels(
+    VOXhandle volume,
+    void (*callback)(VOXuint x, VOXuint y, VOXuint z, void* userData),
+    void* userData)
+{
+    VolumePod* volumePod = CastHandle<VolumePod>(volume, HandleVolume);
+    if (!volumePod || !callback) {
+        ReportError(0, "voxIterateVoxels: invalid volume handle or callback.\n");
+        return;
+    }
+
+    if (volumePod->Hash) {
+        ForEachVoxel(volumePod->Hash, [&](int x, int y, int z) { callback(x, y, z, userData); });
+        return;
+    }
+    if (volumePod->Octree) {
+        ForEachOctreeVoxel(volumePod->Octree, [&](int x, int y, int z) { callback(x, y, z, userData); });
+        return;
+    }
+
+    const VOXuint bytesPerVoxel = volumePod->BytesPerVoxel ? volumePod->BytesPerVoxel : 1;
+    const unsigned char zero[16] = { 0 };
+    std::vector<unsigned char> row((size_t) volumePod->Width * bytesPerVoxel);
+    for (VOXuint z = 0; z < volumePod->Depth; ++z)
+        for (VOXuint y = 0; y < volumePod->Height; ++y) {
+            ReadVoxelSpan(volumePod, 0, y, z, volumePod->Width, &row[0]);
+            for (VOXuint x = 0; x < volumePod->Width; ++x)
+                if (memcmp(&row[x * bytesPerVoxel], zero, bytesPerVoxel))
+                    callback(x, y, z, userData);
+        }
+}
+
+namespace OpenVOX {
+
+void DeleteVolume(VolumePod* volume)
+{
+    ForgetParamHandle(volume);
+    DetachSources(volume);
+    if (volume->OwnsData)
+        free(volume->Data);
+    if (volume->Bricks)
+        DestroyBrickIndex(volume->Bricks);
+    if (volume->Hash)
+        DestroyVoxelHash(volume->Hash);
+    if (volume->Octree)
+        DestroyOctree(volume->Octree);
+    volume->Kind = (HandleKind) 0;
+    delete volume;
+}
+
+} // namespace OpenVOX
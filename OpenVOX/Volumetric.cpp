@@ -0,0 +1,164 @@
+#include "Common.hpp"
+#include <math.h>
+#include <algorithm>
+
+#define X 0
+#define Y 1
+#define Z 2
+
+namespace OpenVOX {
+
+// Solid voxelization by scanline crossing counts.  Every (y, z) row of voxel centers is a
+// ray along +X; each triangle the ray passes through contributes a crossing whose sign
+// comes from the triangle's facing, just like the +1/-1 blending of Voxelize.FS.  Voxels
+// whose center lies behind a non-zero running sum of crossings are inside.
+//
+// Rays that graze a shared edge or vertex are assigned to exactly one of the triangles by
+// a top-left rule on the triangle's YZ projection, so closed meshes stay watertight.
+
+struct Crossing {
+    double Position;
+    VOXuint Row;
+    int Sign;
+};
+
+static bool operator<(const Crossing& a, const Crossing& b)
+{
+    return a.Position < b.Position;
+}
+
+// Edge (a, b) of a counter-clockwise triangle owns the rays lying exactly on it if it is
+// a "top" edge (horizontal, pointing in -Y) or a "left" edge (pointing in -Z).
+static inline bool TopLeft(double ay, double az, double by, double bz)
+{
+    return (az == bz && by < ay) || bz < az;
+}
+
+static inline bool Covers(double w, bool topLeft)
+{
+    return w > 0 || (w == 0 && topLeft);
+}
+
+static void GatherCrossings(const MeshPod* mesh, VOXuint triangle, const GridPod& grid, VOXuint height,
+                            std::vector<Crossing>& crossings)
+{
+    const VOXuint* indices = &mesh->Indices[triangle * 3];
+    double v[3][3];
+    for (int i = 0; i < 3; ++i) {
+        if (indices[i] >= mesh->VertexCount)
+            return;
+        const float* p = &mesh->Positions[indices[i] * 3];
+        for (int c = 0; c < 3; ++c)
+            v[i][c] = (double) p[c] + grid.Offset[c];
+    }
+
+    // Twice the signed area of the YZ projection; its sign is the triangle's facing along X.
+    // The ray enters a counter-clockwise mesh through faces that point towards -X.
+    double area = (v[1][Y] - v[0][Y]) * (v[2][Z] - v[0][Z]) - (v[1][Z] - v[0][Z]) * (v[2][Y] - v[0][Y]);
+    if (area == 0)
+        return;
+
+    int sign = area < 0 ? 1 : -1;
+    if (area < 0) {
+        for (int c = 0; c < 3; ++c) {
+            double t = v[1][c]; v[1][c] = v[2][c]; v[2][c] = t;
+        }
+    }
+
+    double nx = (v[1][Y] - v[0][Y]) * (v[2][Z] - v[0][Z]) - (v[1][Z] - v[0][Z]) * (v[2][Y] - v[0][Y]);
+    double ny = (v[1][Z] - v[0][Z]) * (v[2][X] - v[0][X]) - (v[1][X] - v[0][X]) * (v[2][Z] - v[0][Z]);
+    double nz = (v[1][X] - v[0][X]) * (v[2][Y] - v[0][Y]) - (v[1][Y] - v[0][Y]) * (v[2][X] - v[0][X]);
+    double d = nx * v[0][X] + ny * v[0][Y] + nz * v[0][Z];
+
+    bool topLeft[3];
+    for (int e = 0; e < 3; ++e)
+        topLeft[e] = TopLeft(v[e][Y], v[e][Z], v[(e + 1) % 3][Y], v[(e + 1) % 3][Z]);
+
+    // Rows whose centers can fall inside the projection, padded by one so that rounding
+    // never hides a row from the edge tests, which make the exact decision.
+    int lo[2], hi[2];
+    for (int c = Y; c <= Z; ++c) {
+        double mn = std::min(v[0][c], std::min(v[1][c], v[2][c]));
+        double mx = std::max(v[0][c], std::max(v[1][c], v[2][c]));
+        lo[c - 1] = (int) std::max(0.0, ceil(mn * grid.Scale[c]) - 1);
+        hi[c - 1] = (int) std::min(grid.Extent[c] - 1.0, floor(mx * grid.Scale[c]) + 1);
+    }
+
+    for (int z = lo[1]; z <= hi[1]; ++z)
+        for (int y = lo[0]; y <= hi[0]; ++y) {
+            double py = y * (double) grid.Delta[Y], pz = z * (double) grid.Delta[Z];
+            bool inside = true;
+            for (int e = 0; e < 3 && inside; ++e) {
+                const double* a = v[e];
+                const double* b = v[(e + 1) % 3];
+                double w = (b[Y] - a[Y]) * (pz - a[Z]) - (b[Z] - a[Z]) * (py - a[Y]);
+                inside = Covers(w, topLeft[e]);
+            }
+            if (!inside)
+                continue;
+
+            Crossing crossing;
+            crossing.Position = (d - ny * py - nz * pz) / nx;
+            crossing.Row = y + height * z;
+            crossing.Sign = sign;
+            crossings.push_back(crossing);
+        }
+}
+
+void VoxelizeVolumetric(MeshPod* mesh, VolumePod* volume, const GridPod& grid)
+{
+    ContextPod* context = mesh->Context;
+    unsigned int threadCount = GetThreadCount(context->Pool);
+
+    // Each thread gathers the crossings of its triangles; a counting sort then makes every
+    // row's crossings contiguous, and each row is put in order along X as it is filled.
+    std::vector< std::vector<Crossing> > gathered(threadCount);
+    ParallelFor(context->Pool, mesh->TriangleCount, 256,
+        [&](size_t begin, size_t end, unsigned int thread) {
+            for (size_t t = begin; t < end; ++t)
+                GatherCrossings(mesh, (VOXuint) t, grid, volume->Height, gathered[thread]);
+        });
+
+    size_t rowCount = (size_t) volume->Height * volume->Depth;
+    std::vector<size_t> rowStart(rowCount + 1, 0);
+    for (unsigned int i = 0; i < threadCount; ++i)
+        for (size_t j = 0; j < gathered[i].size(); ++j)
+            rowStart[gathered[i][j].Row + 1]++;
+    for (size_t row = 0; row < rowCount; ++row)
+        rowStart[row + 1] += rowStart[row];
+
+    std::vector<Crossing> crossings(rowStart[rowCount]);
+    std::vector<size_t> cursor(rowStart.begin(), rowStart.end() - 1);
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        for (size_t j = 0; j < gathered[i].size(); ++j)
+            crossings[cursor[gathered[i][j].Row]++] = gathered[i][j];
+        std::vector<Crossing>().swap(gathered[i]);
+    }
+
+    size_t spanBytes = volume->Type == VOX_TYPE_BIT ? volume->Width : (size_t) volume->Width * volume->BytesPerVoxel;
+    std::vector<unsigned char> solid(spanBytes, 0xff);
+
+    ParallelFor(context->Pool, rowCount, 64,
+        [&](size_t begin, size_t end, unsigned int) {
+            for (size_t row = begin; row < end; ++row) {
+                int y = (int) (row % volume->Height), z = (int) (row / volume->Height);
+                std::sort(crossings.begin() + rowStart[row], crossings.begin() + rowStart[row + 1]);
+                int winding = 0;
+                for (size_t i = rowStart[row]; i < rowStart[row + 1]; ++i) {
+                    winding += crossings[i].Sign;
+                    if (!winding || i + 1 == rowStart[row + 1])
+                        continue;
+
+                    // Voxels whose centers lie strictly between this crossing and the next.
+                    double first = floor(crossings[i].Position * grid.Scale[X]) + 1;
+                    double last = ceil(crossings[i + 1].Position * grid.Scale[X]) - 1;
+                    int x0 = (int) std::max(first, 0.0);
+                    int x1 = (int) std::min(last, (double) volume->Width - 1);
+                    if (x0 <= x1)
+                        WriteVoxelSpan(volume, x0, y, z, x1 + 1 - x0, &solid[0]);
+                }
+            }
+        });
+}
+
+} // namespace OpenVOX
@@ -0,0 +1,451 @@
+#include "Common.hpp"
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+using namespace OpenVOX;
+
+#define X 0
+#define Y 1
+#define Z 2
+
+namespace OpenVOX {
+
+// Separating-axis tests for the nine edge/box-axis cross products, ported from the
+// voxelize kernel in Kernels.cl.  http://jgt.akpeters.com/papers/AkenineMoller01/tribox.html
+
+/*======================== X-tests ========================*/
+#define AXISTEST_X01(a, b, fa, fb)                         \
+    p0 = a*v0[Y] - b*v0[Z];                                \
+    p2 = a*v2[Y] - b*v2[Z];                                \
+    minn = p0 < p2 ? p0 : p2; maxx = p0 < p2 ? p2 : p0;    \
+    rad = fa * boxhalfsize[Y] + fb * boxhalfsize[Z];       \
+    if(minn>rad || maxx<-rad) return false;
+
+#define AXISTEST_X2(a, b, fa, fb)                          \
+    p0 = a*v0[Y] - b*v0[Z];                                \
+    p1 = a*v1[Y] - b*v1[Z];                                \
+    minn = p0 < p1 ? p0 : p1; maxx = p0 < p1 ? p1 : p0;    \
+    rad = fa * boxhalfsize[Y] + fb * boxhalfsize[Z];       \
+    if(minn>rad || maxx<-rad) return false;
+
+/*======================== Y-tests ========================*/
+#define AXISTEST_Y02(a, b, fa, fb)                         \
+    p0 = -a*v0[X] + b*v0[Z];                               \
+    p2 = -a*v2[X] + b*v2[Z];                               \
+    minn = p0 < p2 ? p0 : p2; maxx = p0 < p2 ? p2 : p0;    \
+    rad = fa * boxhalfsize[X] + fb * boxhalfsize[Z];       \
+    if(minn>rad || maxx<-rad) return false;
+
+#define AXISTEST_Y1(a, b, fa, fb)                          \
+    p0 = -a*v0[X] + b*v0[Z];                               \
+    p1 = -a*v1[X] + b*v1[Z];                               \
+    minn = p0 < p1 ? p0 : p1; maxx = p0 < p1 ? p1 : p0;    \
+    rad = fa * boxhalfsize[X] + fb * boxhalfsize[Z];       \
+    if(minn>rad || maxx<-rad) return false;
+
+/*======================== Z-tests ========================*/
+#define AXISTEST_Z12(a, b, fa, fb)                         \
+    p1 = a*v1[X] - b*v1[Y];                                \
+    p2 = a*v2[X] - b*v2[Y];                                \
+    minn = p1 < p2 ? p1 : p2; maxx = p1 < p2 ? p2 : p1;    \
+    rad = fa * boxhalfsize[X] + fb * boxhalfsize[Y];       \
+    if(minn>rad || maxx<-rad) return false;
+
+#define AXISTEST_Z0(a, b, fa, fb)                          \
+    p0 = a*v0[X] - b*v0[Y];                                \
+    p1 = a*v1[X] - b*v1[Y];                                \
+    minn = p0 < p1 ? p0 : p1; maxx = p0 < p1 ? p1 : p0;    \
+    rad = fa * boxhalfsize[X] + fb * boxhalfsize[Y];       \
+    if(minn>rad || maxx<-rad) return false;
+
+static inline bool triBoxOverlap(
+    const float boxhalfsize[3],
+    const float v0[3], const float v1[3], const float v2[3],
+    const float e0[3], const float e1[3], const float e2[3],
+    const float fe0[3], const float fe1[3], const float fe2[3])
+{
+    float minn,maxx,p0,p1,p2,rad;
+    AXISTEST_X01(e0[Z], e0[Y], fe0[Z], fe0[Y]);
+    AXISTEST_Y02(e0[Z], e0[X], fe0[Z], fe0[X]);
+    AXISTEST_Z12(e0[Y], e0[X], fe0[Y], fe0[X]);
+    AXISTEST_X01(e1[Z], e1[Y], fe1[Z], fe1[Y]);
+    AXISTEST_Y02(e1[Z], e1[X], fe1[Z], fe1[X]);
+    AXISTEST_Z0(e1[Y], e1[X], fe1[Y], fe1[X]);
+    AXISTEST_X2(e2[Z], e2[Y], fe2[Z], fe2[Y]);
+    AXISTEST_Y1(e2[Z], e2[X], fe2[Z], fe2[X]);
+    AXISTEST_Z12(e2[Y], e2[X], fe2[Y], fe2[X]);
+    return true;
+}
+
+// The X-axis tests do not depend on x, so they can reject a whole row at once.
+bool TestRowAxisX(const TrianglePod& tri, const GridPod& grid, int y, int z)
+{
+    float minn,maxx,p0,p1,p2,rad;
+    float v0[3], v1[3], v2[3];
+    const float* boxhalfsize = grid.HalfSize;
+    float cy = y * grid.Delta[Y], cz = z * grid.Delta[Z];
+    v0[Y] = tri.V[0][Y] - cy; v1[Y] = tri.V[1][Y] - cy; v2[Y] = tri.V[2][Y] - cy;
+    v0[Z] = tri.V[0][Z] - cz; v1[Z] = tri.V[1][Z] - cz; v2[Z] = tri.V[2][Z] - cz;
+    AXISTEST_X01(tri.E[0][Z], tri.E[0][Y], tri.FE[0][Z], tri.FE[0][Y]);
+    AXISTEST_X01(tri.E[1][Z], tri.E[1][Y], tri.FE[1][Z], tri.FE[1][Y]);
+    AXISTEST_X2(tri.E[2][Z], tri.E[2][Y], tri.FE[2][Z], tri.FE[2][Y]);
+    return true;
+}
+
+static inline int clampi(int v, int lo, int hi) { return v < lo ? lo : (v > hi ? hi : v); }
+
+GridPod CreateGrid(const VolumePod* volume, const float minCorner[3], const float maxCorner[3])
+{
+    GridPod grid;
+    grid.Extent[X] = volume->Width;
+    grid.Extent[Y] = volume->Height;
+    grid.Extent[Z] = volume->Depth;
+    for (int c = 0; c < 3; ++c) {
+        grid.Scale[c] = grid.Extent[c] / (maxCorner[c] - minCorner[c]);
+        grid.Offset[c] = -minCorner[c];
+        grid.Delta[c] = 1.0f / grid.Scale[c];
+        grid.HalfSize[c] = 0.5f * grid.Delta[c];
+    }
+    return grid;
+}
+
+// Clamped voxel-space bounding box of a triangle given in world space, quantized exactly
+// like the kernel, including truncation toward zero.
+void QuantizeBounds(const float* v0, const float* v1, const float* v2, const GridPod& grid, int minCorner[3], int maxCorner[3])
+{
+    for (int c = 0; c < 3; ++c) {
+        int i0 = (int) ((v0[c] + grid.Offset[c]) * grid.Scale[c]);
+        int i1 = (int) ((v1[c] + grid.Offset[c]) * grid.Scale[c]);
+        int i2 = (int) ((v2[c] + grid.Offset[c]) * grid.Scale[c]);
+        int lo = i0 < i1 ? (i0 < i2 ? i0 : i2) : (i1 < i2 ? i1 : i2);
+        int hi = i0 > i1 ? (i0 > i2 ? i0 : i2) : (i1 > i2 ? i1 : i2);
+        minCorner[c] = clampi(lo, 0, grid.Extent[c] - 1);
+        maxCorner[c] = clampi(hi + 1, 0, grid.Extent[c] - 1);
+    }
+}
+
+// Gathers a triangle's vertices (shifted by the grid offset), its edges, and its
+// clamped voxel-space bounding box.  Returns false for degenerate index data.
+bool SetupTriangle(const MeshPod* mesh, VOXuint triangle, const GridPod& grid, TrianglePod& tri)
+{
+    const VOXuint* indices = &mesh->Indices[triangle * 3];
+    for (int v = 0; v < 3; ++v) {
+        if (indices[v] >= mesh->VertexCount)
+            return false;
+        const float* p = &mesh->Positions[indices[v] * 3];
+        for (int c = 0; c < 3; ++c)
+            tri.V[v][c] = p[c] + grid.Offset[c];
+    }
+
+    for (int c = 0; c < 3; ++c) {
+        tri.E[0][c] = tri.V[1][c] - tri.V[0][c];
+        tri.E[1][c] = tri.V[2][c] - tri.V[1][c];
+        tri.E[2][c] = tri.V[0][c] - tri.V[2][c];
+        for (int e = 0; e < 3; ++e)
+            tri.FE[e][c] = tri.E[e][c] < 0 ? -tri.E[e][c] : tri.E[e][c];
+    }
+
+    QuantizeBounds(&mesh->Positions[indices[0] * 3], &mesh->Positions[indices[1] * 3], &mesh->Positions[indices[2] * 3],
+                   grid, tri.Min, tri.Max);
+
+    tri.N[X] = tri.E[0][Y] * tri.E[1][Z] - tri.E[0][Z] * tri.E[1][Y];
+    tri.N[Y] = tri.E[0][Z] * tri.E[1][X] - tri.E[0][X] * tri.E[1][Z];
+    tri.N[Z] = tri.E[0][X] * tri.E[1][Y] - tri.E[0][Y] * tri.E[1][X];
+    float d0 = tri.N[X] * tri.V[0][X] + tri.N[Y] * tri.V[0][Y] + tri.N[Z] * tri.V[0][Z];
+    float d1 = tri.N[X] * tri.V[1][X] + tri.N[Y] * tri.V[1][Y] + tri.N[Z] * tri.V[1][Z];
+    float d2 = tri.N[X] * tri.V[2][X] + tri.N[Y] * tri.V[2][Y] + tri.N[Z] * tri.V[2][Z];
+    tri.DMin = std::min(d0, std::min(d1, d2));
+    tri.DMax = std::max(d0, std::max(d1, d2));
+    return true;
+}
+
+// Narrows [lo, hi] to the voxels of row (y, z) whose boxes reach the triangle's plane, i.e.
+// whose centers lie in the plane thickened by the box's projected radius.  Returns false
+// if the row misses that slab entirely.  Degenerate triangles have no normal and keep the
+// whole row.  The slab spans the vertices' own distances along the normal, so slivers,
+// whose normals are mostly rounding error, still keep every voxel they touch.
+static bool ClipRowToPlane(const TrianglePod& tri, const GridPod& grid, int y, int z, int& lo, int& hi)
+{
+    float r = fabsf(tri.N[X]) * grid.HalfSize[X] + fabsf(tri.N[Y]) * grid.HalfSize[Y] + fabsf(tri.N[Z]) * grid.HalfSize[Z];
+    float s = tri.N[Y] * (y * grid.Delta[Y]) + tri.N[Z] * (z * grid.Delta[Z]);
+    float nx = tri.N[X] * grid.Delta[X];
+    if (nx == 0)
+        return s >= tri.DMin - r && s <= tri.DMax + r;
+
+    float a = (tri.DMin - r - s) / nx, b = (tri.DMax + r - s) / nx;
+    if (a > b) { float t = a; a = b; b = t; }
+
+    // Pad by a sliver of a voxel so that rounding never drops a box that touches the slab.
+    a -= 1.0f / 1024; b += 1.0f / 1024;
+    if (!(b >= lo && a <= hi))
+        return false;
+    if (a > lo) lo = (int) ceilf(a);
+    if (b < hi) hi = (int) floorf(b);
+    return lo <= hi;
+}
+
+// Tests up to 64 consecutive voxels of the row (y, z) starting at x; bit i of the result is voxel x + i.
+unsigned long long TestRowScalar(const TrianglePod& tri, const GridPod& grid, int x, int count, int y, int z)
+{
+    float v0[3], v1[3], v2[3];
+    float cy = y * grid.Delta[Y], cz = z * grid.Delta[Z];
+    v0[Y] = tri.V[0][Y] - cy; v1[Y] = tri.V[1][Y] - cy; v2[Y] = tri.V[2][Y] - cy;
+    v0[Z] = tri.V[0][Z] - cz; v1[Z] = tri.V[1][Z] - cz; v2[Z] = tri.V[2][Z] - cz;
+
+    unsigned long long mask = 0;
+    for (int i = 0; i < count; ++i) {
+        float cx = (x + i) * grid.Delta[X];
+        v0[X] = tri.V[0][X] - cx; v1[X] = tri.V[1][X] - cx; v2[X] = tri.V[2][X] - cx;
+        if (triBoxOverlap(grid.HalfSize, v0, v1, v2, tri.E[0], tri.E[1], tri.E[2], tri.FE[0], tri.FE[1], tri.FE[2]))
+            mask |= 1ull << i;
+    }
+    return mask;
+}
+
+// Sets the voxels of row (y, z) flagged in the mask; bit i is voxel x + i.
+void WriteRow(VolumePod* volume, int x, int y, int z, unsigned long long mask)
+{
+    // Bit volumes take the whole mask with at most two word-sized atomic ORs.
+    if (volume->Type == VOX_TYPE_BIT) {
+        unsigned long long* row = (unsigned long long*) (volume->Data + VoxelOffset(volume, 0, y, z)) + (x >> 6);
+        AtomicOr(row, mask << (x & 63));
+        if ((x & 63) && (mask >> (64 - (x & 63))))
+            AtomicOr(row + 1, mask >> (64 - (x & 63)));
+        return;
+    }
+
+    if (volume->Octree) {
+        AppendOctreeVoxels(volume->Octree, x, y, z, mask);
+        return;
+    }
+
+    if (volume->Hash) {
+        while (mask) {
+            InsertVoxel(volume->Hash, x + LowestBit(mask), y, z);
+            mask &= mask - 1;
+        }
+        return;
+    }
+
+    while (mask) {
+        int i = LowestBit(mask);
+        mask &= mask - 1;
+
+        // Every writer stores the same value, so racing threads cannot disagree.
+        unsigned char* voxel = TouchVoxel(volume, x + i, y, z);
+        if (voxel)
+            memset(voxel, 0xff, volume->BytesPerVoxel);
+    }
+}
+
+// Work is handed out as grid-aligned bricks of a triangle's bounding box rather than as
+// whole triangles, so a single long helix triangle is spread across every thread instead
+// of stalling the batch while its neighbours idle.
+static const int JobSize[3] = { 32, 8, 8 };
+
+// True if any brick overlapping the voxel box [lo, hi] is flagged.
+static bool AnyDirty(const BrickMask& dirty, const int lo[3], const int hi[3])
+{
+    for (int bz = lo[Z] >> BrickShift; bz <= hi[Z] >> BrickShift; ++bz)
+        for (int by = lo[Y] >> BrickShift; by <= hi[Y] >> BrickShift; ++by)
+            for (int bx = lo[X] >> BrickShift; bx <= hi[X] >> BrickShift; ++bx)
+                if (dirty.Test(bx, by, bz))
+                    return true;
+    return false;
+}
+
+static size_t CountJobs(const TrianglePod& tri)
+{
+    size_t count = 1;
+    for (int c = 0; c < 3; ++c)
+        count *= tri.Max[c] / JobSize[c] - tri.Min[c] / JobSize[c] + 1;
+    return count;
+}
+
+static void VoxelizeJob(RowTestFunc testRow, bool planeSpans, const BrickMask* dirty,
+                        VolumePod* volume, const GridPod& grid, const TrianglePod& tri, size_t job)
+{
+    int lo[3], hi[3];
+    for (int c = 0; c < 3; ++c) {
+        int first = tri.Min[c] / JobSize[c];
+        int count = tri.Max[c] / JobSize[c] - first + 1;
+        int brick = first + (int) (c < 2 ? job % count : job);
+        job /= count;
+        lo[c] = brick * JobSize[c] > tri.Min[c] ? brick * JobSize[c] : tri.Min[c];
+        hi[c] = brick * JobSize[c] + JobSize[c] - 1 < tri.Max[c] ? brick * JobSize[c] + JobSize[c] - 1 : tri.Max[c];
+    }
+
+    if (dirty && !AnyDirty(*dirty, lo, hi))
+        return;
+
+    for (int z = lo[Z]; z <= hi[Z]; ++z)
+        for (int y = lo[Y]; y <= hi[Y]; ++y) {
+            int x0 = lo[X], x1 = hi[X];
+            if (planeSpans && !ClipRowToPlane(tri, grid, y, z, x0, x1))
+                continue;
+
+            // When redoing dirty bricks, only voxels inside them may be written.
+            unsigned long long keep = ~0ull;
+            if (dirty) {
+                keep = 0;
+                for (int x = x0; x <= x1; x = (x | (BrickSize - 1)) + 1)
+                    if (dirty->Test(x >> BrickShift, y >> BrickShift, z >> BrickShift)) {
+                        int end = (x | (BrickSize - 1)) < x1 ? (x | (BrickSize - 1)) : x1;
+                        keep |= (~0ull >> (63 - (end - x))) << (x - x0);
+                    }
+                if (!keep)
+                    continue;
+            }
+
+            unsigned long long mask = testRow(tri, grid, x0, x1 + 1 - x0, y, z) & keep;
+            if (mask)
+                WriteRow(volume, x0, y, z, mask);
+        }
+}
+
+// Lists the mesh's triangles whose bounding boxes reach a flagged brick.
+void CullTriangles(const MeshPod* mesh, const GridPod& grid, const BrickMask& dirty, std::vector<VOXuint>& triangles)
+{
+    triangles.clear();
+    const float* p = mesh->Positions.empty() ? 0 : &mesh->Positions[0];
+    for (VOXuint t = 0; t < mesh->TriangleCount; ++t) {
+        const VOXuint* i = &mesh->Indices[t * 3];
+        if (i[0] >= mesh->VertexCount || i[1] >= mesh->VertexCount || i[2] >= mesh->VertexCount)
+            continue;
+        int lo[3], hi[3];
+        QuantizeBounds(p + i[0] * 3, p + i[1] * 3, p + i[2] * 3, grid, lo, hi);
+        if (AnyDirty(dirty, lo, hi))
+            triangles.push_back(t);
+    }
+}
+
+// Voxelizes the mesh's surface.  With a dirty mask, only the listed triangles are visited,
+// normally those from CullTriangles, and only voxels in flagged bricks are written.
+void VoxelizeSurface(MeshPod* mesh, VolumePod* volume, const GridPod& grid, const BrickMask* dirty, const std::vector<VOXuint>* subset)
+{
+    ContextPod* context = mesh->Context;
+    RowTestFunc testRow = context->TestRow;
+    bool planeSpans = GetParams().PlaneSpans != VOX_FALSE;
+    std::vector<TrianglePod>& triangles = context->Triangles;
+    std::vector<size_t>& jobOffsets = context->JobOffsets;
+    size_t count = dirty ? subset->size() : mesh->TriangleCount;
+    triangles.resize(count);
+    jobOffsets.resize(count + 1);
+
+    // Setup pass: one brick count per triangle, followed by an exclusive prefix sum.
+    jobOffsets[0] = 0;
+    ParallelFor(context->Pool, count, 256,
+        [&](size_t begin, size_t end, unsigned int) {
+            for (size_t t = begin; t < end; ++t)
+                jobOffsets[t + 1] = SetupTriangle(mesh, dirty ? (*subset)[t] : (VOXuint) t, grid, triangles[t]) ?
+                    CountJobs(triangles[t]) : 0;
+        });
+    for (size_t t = 0; t < count; ++t)
+        jobOffsets[t + 1] += jobOffsets[t];
+
+    // Job pass: each chunk finds its first triangle by bisection, then walks forward.
+    ParallelFor(context->Pool, jobOffsets.back(), 16,
+        [&](size_t begin, size_t end, unsigned int) {
+            size_t t = std::upper_bound(jobOffsets.begin(), jobOffsets.end(), begin) - jobOffsets.begin() - 1;
+            for (size_t job = begin; job < end; ++job) {
+                while (jobOffsets[t + 1] <= job)
+                    ++t;
+                VoxelizeJob(testRow, planeSpans, dirty, volume, grid, triangles[t], job - jobOffsets[t]);
+            }
+        });
+}
+
+// Rough number of voxels a surface pass will set: each triangle's area in voxel units,
+// scaled by how many voxels a plane of its orientation cuts per unit area, plus a voxel
+// per unit of perimeter.  Shared edges are counted twice, which errs on the high side.
+size_t EstimateSurfaceVoxels(const MeshPod* mesh, const GridPod& grid)
+{
+    double estimate = 0;
+    for (VOXuint t = 0; t < mesh->TriangleCount; ++t) {
+        const VOXuint* indices = &mesh->Indices[t * 3];
+        if (indices[0] >= mesh->VertexCount || indices[1] >= mesh->VertexCount || indices[2] >= mesh->VertexCount)
+            continue;
+
+        double p[3][3];
+        for (int i = 0; i < 3; ++i)
+            for (int c = 0; c < 3; ++c)
+                p[i][c] = mesh->Positions[indices[i] * 3 + c] * (double) grid.Scale[c];
+
+        double e0[3], e1[3], e2[3];
+        for (int c = 0; c < 3; ++c) {
+            e0[c] = p[1][c] - p[0][c];
+            e1[c] = p[2][c] - p[1][c];
+            e2[c] = p[0][c] - p[2][c];
+        }
+        double n[3] = { e0[Y] * e1[Z] - e0[Z] * e1[Y], e0[Z] * e1[X] - e0[X] * e1[Z], e0[X] * e1[Y] - e0[Y] * e1[X] };
+        double perimeter = sqrt(e0[X] * e0[X] + e0[Y] * e0[Y] + e0[Z] * e0[Z]) +
+                           sqrt(e1[X] * e1[X] + e1[Y] * e1[Y] + e1[Z] * e1[Z]) +
+                           sqrt(e2[X] * e2[X] + e2[Y] * e2[Y] + e2[Z] * e2[Z]);
+        estimate += 0.5 * (fabs(n[X]) + fabs(n[Y]) + fabs(n[Z])) + perimeter + 1;
+    }
+    return (size_t) estimate;
+}
+
+} // namespace OpenVOX
+
+void voxVoxelize(VOXhandle mesh, VOXhandle volume, VOXenum voxelizeOp)
+{
+    MeshPod* meshPod = CastHandle<MeshPod>(mesh, HandleMesh);
+    VolumePod* volumePod = CastHandle<VolumePod>(volume, HandleVolume);
+    if (!meshPod || !volumePod) {
+        ReportError(0, "voxVoxelize: invalid mesh or volume handle.\n");
+        return;
+    }
+
+    if (meshPod->VertexBuffer && !RefreshMesh(meshPod))
+        return;
+
+    const ParamBlock& params = GetParams();
+    const float* minCorner = params.VoxelizeBoundsEnable ? &params.VoxelizeBounds[0] : meshPod->MinCorner;
+    const float* maxCorner = params.VoxelizeBoundsEnable ? &params.VoxelizeBounds[3] : meshPod->MaxCorner;
+    for (int c = 0; c < 3; ++c) {
+        if (!(maxCorner[c] > minCorner[c])) {
+            ReportError(meshPod->Context, "voxVoxelize: voxelization bounds are empty.\n");
+            return;
+        }
+    }
+
+    GridPod grid = CreateGrid(volumePod, minCorner, maxCorner);
+
+    if (voxelizeOp == VOX_VOXELIZE_SPATIAL_HASH && !volumePod->Hash) {
+        ReportError(meshPod->Context, "voxVoxelize: VOX_VOXELIZE_SPATIAL_HASH needs a VOX_STORAGE_HASH volume.\n");
+        return;
+    }
+
+    // Octrees are rebuilt from scratch around the new voxels, and only by this mode.
+    if ((voxelizeOp == VOX_VOXELIZE_SURFACE_OCTREE) != (volumePod->Octree != 0)) {
+        ReportError(meshPod->Context, "voxVoxelize: VOX_VOXELIZE_SURFACE_OCTREE goes with VOX_STORAGE_OCTREE volumes, and only with them.\n");
+        return;
+    }
+    if (volumePod->Octree) {
+        VoxelizeOctree(meshPod, volumePod, grid);
+        return;
+    }
+
+    // A pass that overflows a hash volume is run again on a larger table, so hash volumes do
+    // not take part in incremental voxelization, which could not be repeated.
+    if (volumePod->Hash)
+        ReserveVoxelHash(volumePod->Hash, EstimateSurfaceVoxels(meshPod, grid));
+    RepeatOnOverflow(volumePod, [&]() {
+        switch (voxelizeOp)
+        {
+            case VOX_VOXELIZE_SURFACE_CONSERVATIVE:
+                if (params.Incremental && !volumePod->Hash)
+                    VoxelizeIncremental(meshPod, volumePod, grid);
+                else
+                    VoxelizeSurface(meshPod, volumePod, grid, 0, 0);
+                break;
+            case VOX_VOXELIZE_SPATIAL_HASH: VoxelizeSurface(meshPod, volumePod, grid, 0, 0); break;
+            case VOX_VOXELIZE_SURFACE_THIN: VoxelizeThin(meshPod, volumePod, grid); break;
+            case VOX_VOXELIZE_VOLUMETRIC: VoxelizeVolumetric(meshPod, volumePod, grid); break;
+            case VOX_VOXELIZE_SURFACE_REFERENCE: VoxelizeReference(meshPod, volumePod, minCorner, maxCorner); break;
+            default: ReportError(meshPod->Context, "voxVoxelize: unsupported operation 0x%4.4x.\n", voxelizeOp);
+        }
+    });
+}
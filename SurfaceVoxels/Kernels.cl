@@ -1,231 +1,689 @@
--- Surfaces
-
-#pragma OPENCL EXTENSION cl_khr_byte_addressable_store: enable
-
-#define X 0
-#define Y 1
-#define Z 2
-
-#define SUB(dest,v1,v2) \
-          dest[X]=v1[X]-v2[X]; \
-          dest[Y]=v1[Y]-v2[Y]; \
-          dest[Z]=v1[Z]-v2[Z]; 
-
-/*======================== X-tests ========================*/
-#define AXISTEST_X01(a, b, fa, fb)			   \
-	p0 = a*v0[Y] - b*v0[Z];			       	   \
-	p2 = a*v2[Y] - b*v2[Z];			       	   \
-	minn = min(p0,p2); maxx = max(p0, p2);     \
-	rad = fa * boxhalfsize[Y] + fb * boxhalfsize[Z];   \
-	if(minn>rad || maxx<-rad) return 0;
-
-#define AXISTEST_X2(a, b, fa, fb)			   \
-	p0 = a*v0[Y] - b*v0[Z];			           \
-	p1 = a*v1[Y] - b*v1[Z];			       	   \
-	minn = min(p0,p1); maxx = max(p0, p1);     \
-	rad = fa * boxhalfsize[Y] + fb * boxhalfsize[Z];   \
-	if(minn>rad || maxx<-rad) return 0;
-
-/*======================== Y-tests ========================*/
-#define AXISTEST_Y02(a, b, fa, fb)			   \
-	p0 = -a*v0[X] + b*v0[Z];		      	   \
-	p2 = -a*v2[X] + b*v2[Z];	       	       	   \
-	minn = min(p0,p2); maxx = max(p0, p2);     \
-	rad = fa * boxhalfsize[X] + fb * boxhalfsize[Z];   \
-	if(minn>rad || maxx<-rad) return 0;
-
-#define AXISTEST_Y1(a, b, fa, fb)			   \
-	p0 = -a*v0[X] + b*v0[Z];		      	   \
-	p1 = -a*v1[X] + b*v1[Z];	     	       	   \
-	minn = min(p0,p1); maxx = max(p0, p1);     \
-	rad = fa * boxhalfsize[X] + fb * boxhalfsize[Z];   \
-	if(minn>rad || maxx<-rad) return 0;
-
-/*======================== Z-tests ========================*/
-
-#define AXISTEST_Z12(a, b, fa, fb)			   \
-	p1 = a*v1[X] - b*v1[Y];			           \
-	p2 = a*v2[X] - b*v2[Y];			       	   \
-	minn = min(p1,p2); maxx = max(p1, p2);     \
-	rad = fa * boxhalfsize[X] + fb * boxhalfsize[Y];   \
-	if(minn>rad || maxx<-rad) return 0;
-
-#define AXISTEST_Z0(a, b, fa, fb)			   \
-	p0 = a*v0[X] - b*v0[Y];				   \
-	p1 = a*v1[X] - b*v1[Y];			           \
-	minn = min(p0,p1); maxx = max(p0, p1);     \
-	rad = fa * boxhalfsize[X] + fb * boxhalfsize[Y];   \
-	if(minn>rad || maxx<-rad) return 0;
-
-inline int triBoxOverlap(
-    float boxhalfsize[3],
-    float v0[3], float v1[3], float v2[3],
-    float e0[3], float e1[3], float e2[3],
-    float fe0[3], float fe1[3], float fe2[3])
-{
-   float minn,maxx,p0,p1,p2,rad;
-   AXISTEST_X01(e0[Z], e0[Y], fe0[Z], fe0[Y]);
-   AXISTEST_Y02(e0[Z], e0[X], fe0[Z], fe0[X]);
-   AXISTEST_Z12(e0[Y], e0[X], fe0[Y], fe0[X]);
-   AXISTEST_X01(e1[Z], e1[Y], fe1[Z], fe1[Y]);
-   AXISTEST_Y02(e1[Z], e1[X], fe1[Z], fe1[X]);
-   AXISTEST_Z0(e1[Y], e1[X], fe1[Y], fe1[X]);
-   AXISTEST_X2(e2[Z], e2[Y], fe2[Z], fe2[Y]);
-   AXISTEST_Y1(e2[Z], e2[X], fe2[Z], fe2[X]);
-   AXISTEST_Z12(e2[Y], e2[X], fe2[Y], fe2[X]);
-   return 1;
-}
-
-kernel void voxelize(
-    write_only global uchar* volume,
-    float xscale, float yscale, float zscale,
-    float xoffset, float yoffset, float zoffset,
-    int rowPitch, int slicePitch,
-    int width, int height, int depth,
-    read_only global const float* verts, read_only global const uint* faces, uint triangleCount)
-{
-    float normal[3],e0[3],e1[3],e2[3];
-    const uint triangleIndex = get_global_id(0);
-
-    // due to quantization into grids, there can be more threads than triangles:
-    if (triangleIndex >= triangleCount)
-        return;
-        
-    uint A = faces[3*triangleIndex];
-    uint B = faces[3*triangleIndex+1];
-    uint C = faces[3*triangleIndex+2];
-    
-    float Ax = verts[A*3];
-    float Ay = verts[A*3+1];
-    float Az = verts[A*3+2];
-    
-    int iAx = (int) ((Ax + xoffset) * xscale);
-    int iAy = (int) ((Ay + yoffset) * yscale);
-    int iAz = (int) ((Az + zoffset) * zscale);
-    
-    float Bx = verts[B*3];
-    float By = verts[B*3+1];
-    float Bz = verts[B*3+2];
-
-    int iBx = (int) ((Bx + xoffset) * xscale);
-    int iBy = (int) ((By + yoffset) * yscale);
-    int iBz = (int) ((Bz + zoffset) * zscale);
-
-    float Cx = verts[C*3];
-    float Cy = verts[C*3+1];
-    float Cz = verts[C*3+2];
-
-    int iCx = (int) ((Cx + xoffset) * xscale);
-    int iCy = (int) ((Cy + yoffset) * yscale);
-    int iCz = (int) ((Cz + zoffset) * zscale);
-    
-    int minX = min(min(iAx, iBx), iCx);
-    int minY = min(min(iAy, iBy), iCy);
-    int minZ = min(min(iAz, iBz), iCz);
-    int maxX = max(max(iAx, iBx), iCx)+1;
-    int maxY = max(max(iAy, iBy), iCy)+1;
-    int maxZ = max(max(iAz, iBz), iCz)+1;
-    
-    minX = min(width-1,max(minX, 0));
-    minY = min(height-1,max(minY, 0));
-    minZ = min(depth-1,max(minZ, 0));
-    maxX = min(width-1,max(maxX, 0));
-    maxY = min(height-1,max(maxY, 0));
-    maxZ = min(depth-1,max(maxZ, 0));
-
-    float delta[3] = { 1.0/xscale, 1.0/yscale, 1.0/zscale };
-    float boxhalfsize[3] = { 0.5*delta[X], 0.5*delta[Y], 0.5*delta[Z] };
-    float triverts[3][3] = { { Ax, Ay, Az}, {Bx, By, Bz}, {Cx, Cy, Cz} };
-    float boxcenter[3] = { minX*delta[X] - xoffset, minY*delta[Y] - yoffset, minZ*delta[Z] - zoffset };
-
-    float v0[3] = {Ax, Ay, Az};
-    float v1[3] = {Bx, By, Bz};
-    float v2[3] = {Cx, Cy, Cz};
-    SUB(e0,v1,v0);
-    SUB(e1,v2,v1);
-    SUB(e2,v0,v2);
-    
-    float fe0[3] = {fabs(e0[X]), fabs(e0[Y]), fabs(e0[Z])};
-    float fe1[3] = {fabs(e1[X]), fabs(e1[Y]), fabs(e1[Z])};
-    float fe2[3] = {fabs(e2[X]), fabs(e2[Y]), fabs(e2[Z])};
-
-    SUB(v0,triverts[X],boxcenter);
-    SUB(v1,triverts[Y],boxcenter);
-    SUB(v2,triverts[Z],boxcenter);
-
-    volume += minX + minY*rowPitch + (depth-1-minZ)*slicePitch;
-    for (int z = minZ; z <= maxZ; z++) {
-        global uchar* slice = volume;
-        for (int y = minY; y <= maxY; y++) {
-        
-            global uchar* row = slice;
-            for (int x = minX; x <= maxX; x++, row++) {
-                
-                // Do triangle ABC and voxel XYZ intersect?
-                // http://jgt.akpeters.com/papers/AkenineMoller01/tribox.html
-                
-                if (triBoxOverlap(boxhalfsize, v0, v1, v2, e0, e1, e2, fe0, fe1, fe2))
-                    *row = 255;
-                    
-                v0[X] -= delta[X]; v1[X] -= delta[X];  v2[X] -= delta[X];
-            }
-            slice += rowPitch;
-            
-            v0[X] = Ax-boxcenter[X]; v1[X] = Bx-boxcenter[X];  v2[X] = Cx-boxcenter[X];
-            v0[Y] -= delta[Y]; v1[Y] -= delta[Y];  v2[Y] -= delta[Y];
-        }
-        volume -= slicePitch;
-        
-        v0[Z] -= delta[Z]; v1[Z] -= delta[Z];  v2[Z] -= delta[Z];
-        v0[Y] = Ay-boxcenter[Y]; v1[Y] = By-boxcenter[Y];  v2[Y] = Cy-boxcenter[Y];
-    }
-}
-
---------- Scratch Space ---------
-
-kernel void voxelze(write_only image3d_t volume)
-{
-    const int x = get_global_id(0);
-    const int y = get_global_id(1);
-    const int z = get_global_id(2);
-}
-    
-kernel void voxelize(
-    write_only image3d_t volume,
-    read_only global const float3* verts,
-    read_only global const ushort3* faces)
-{
-}
-
-kernel void fast_clear(
-    write_only global uchar* volume,
-    uint width, uint height, uint depth,
-    uint rowPitch, uint slicePitch)
-{
-    int x = get_global_id(0);
-    int y = get_global_id(1);
-    int z = get_global_id(2);
-
-    // due to quantization into grids, there can be more threads than pixels:
-    if (x >= width || y >= height || z >= depth)
-        return;
-    
-    volume[x + y*rowPitch + z*slicePitch] = 0;
-}
-
-kernel void clear(
-    write_only global uchar* volume,
-    uint width, uint height, uint depth,
-    uint rowPitch, uint slicePitch)
-{
-    int x = get_global_id(0);
-    int y = get_global_id(1);
-
-    // due to quantization into grids, there can be more threads than pixels:
-    if (x >= width || y >= height)
-        return;
-    
-    // walk across slices:
-    for (int z = 0; z < depth; ++z)
-        volume[x + y*rowPitch + z*slicePitch] = 0;
-}
+-- Surfaces
+
+#pragma OPENCL EXTENSION cl_khr_byte_addressable_store: enable
+
+#define X 0
+#define Y 1
+#define Z 2
+
+#define SUB(dest,v1,v2) \
+          dest[X]=v1[X]-v2[X]; \
+          dest[Y]=v1[Y]-v2[Y]; \
+          dest[Z]=v1[Z]-v2[Z]; 
+
+/*======================== X-tests ========================*/
+#define AXISTEST_X01(a, b, fa, fb)			   \
+	p0 = a*v0[Y] - b*v0[Z];			       	   \
+	p2 = a*v2[Y] - b*v2[Z];			       	   \
+	minn = min(p0,p2); maxx = max(p0, p2);     \
+	rad = fa * boxhalfsize[Y] + fb * boxhalfsize[Z];   \
+	if(minn>rad || maxx<-rad) return 0;
+
+#define AXISTEST_X2(a, b, fa, fb)			   \
+	p0 = a*v0[Y] - b*v0[Z];			           \
+	p1 = a*v1[Y] - b*v1[Z];			       	   \
+	minn = min(p0,p1); maxx = max(p0, p1);     \
+	rad = fa * boxhalfsize[Y] + fb * boxhalfsize[Z];   \
+	if(minn>rad || maxx<-rad) return 0;
+
+/*======================== Y-tests ========================*/
+#define AXISTEST_Y02(a, b, fa, fb)			   \
+	p0 = -a*v0[X] + b*v0[Z];		      	   \
+	p2 = -a*v2[X] + b*v2[Z];	       	       	   \
+	minn = min(p0,p2); maxx = max(p0, p2);     \
+	rad = fa * boxhalfsize[X] + fb * boxhalfsize[Z];   \
+	if(minn>rad || maxx<-rad) return 0;
+
+#define AXISTEST_Y1(a, b, fa, fb)			   \
+	p0 = -a*v0[X] + b*v0[Z];		      	   \
+	p1 = -a*v1[X] + b*v1[Z];	     	       	   \
+	minn = min(p0,p1); maxx = max(p0, p1);     \
+	rad = fa * boxhalfsize[X] + fb * boxhalfsize[Z];   \
+	if(minn>rad || maxx<-rad) return 0;
+
+/*======================== Z-tests ========================*/
+
+#define AXISTEST_Z12(a, b, fa, fb)			   \
+	p1 = a*v1[X] - b*v1[Y];			           \
+	p2 = a*v2[X] - b*v2[Y];			       	   \
+	minn = min(p1,p2); maxx = max(p1, p2);     \
+	rad = fa * boxhalfsize[X] + fb * boxhalfsize[Y];   \
+	if(minn>rad || maxx<-rad) return 0;
+
+#define AXISTEST_Z0(a, b, fa, fb)			   \
+	p0 = a*v0[X] - b*v0[Y];				   \
+	p1 = a*v1[X] - b*v1[Y];			           \
+	minn = min(p0,p1); maxx = max(p0, p1);     \
+	rad = fa * boxhalfsize[X] + fb * boxhalfsize[Y];   \
+	if(minn>rad || maxx<-rad) return 0;
+
+inline int triBoxOverlap(
+    float boxhalfsize[3],
+    float v0[3], float v1[3], float v2[3],
+    float e0[3], float e1[3], float e2[3],
+    float fe0[3], float fe1[3], float fe2[3])
+{
+   float minn,maxx,p0,p1,p2,rad;
+   AXISTEST_X01(e0[Z], e0[Y], fe0[Z], fe0[Y]);
+   AXISTEST_Y02(e0[Z], e0[X], fe0[Z], fe0[X]);
+   AXISTEST_Z12(e0[Y], e0[X], fe0[Y], fe0[X]);
+   AXISTEST_X01(e1[Z], e1[Y], fe1[Z], fe1[Y]);
+   AXISTEST_Y02(e1[Z], e1[X], fe1[Z], fe1[X]);
+   AXISTEST_Z0(e1[Y], e1[X], fe1[Y], fe1[X]);
+   AXISTEST_X2(e2[Z], e2[Y], fe2[Z], fe2[Y]);
+   AXISTEST_Y1(e2[Z], e2[X], fe2[Z], fe2[X]);
+   AXISTEST_Z12(e2[Y], e2[X], fe2[Y], fe2[X]);
+   return 1;
+}
+
+#ifdef PLANE_SPANS
+// Narrows [lo, hi] to the voxels of row (cy, cz) whose boxes reach the triangle's plane,
+// i.e. whose centers lie in the plane thickened by the box's projected radius.  Returns 0
+// if the row misses that slab.  Degenerate triangles have no normal and keep the whole row.
+// The slab spans the vertices' own distances [dmin, dmax] along the normal, so slivers,
+// whose normals are mostly rounding error, still keep every voxel they touch.
+inline int clipRowToPlane(
+    float normal[3], float dmin, float dmax, float boxhalfsize[3], float delta[3],
+    float xoffset, float cy, float cz, int* lo, int* hi)
+{
+    float r = fabs(normal[X])*boxhalfsize[X] + fabs(normal[Y])*boxhalfsize[Y] + fabs(normal[Z])*boxhalfsize[Z];
+    float s = normal[Y]*cy + normal[Z]*cz - normal[X]*xoffset;
+    float nx = normal[X]*delta[X];
+    if (nx == 0)
+        return s >= dmin - r && s <= dmax + r;
+
+    float a = (dmin - r - s) / nx, b = (dmax + r - s) / nx;
+    float lower = min(a, b) - 1.0f/1024, upper = max(a, b) + 1.0f/1024;
+    if (!(upper >= *lo && lower <= *hi))
+        return 0;
+    if (lower > *lo) *lo = (int) ceil(lower);
+    if (upper < *hi) *hi = (int) floor(upper);
+    return *lo <= *hi;
+}
+#endif
+
+kernel void voxelize(
+    write_only global uchar* volume,
+    float xscale, float yscale, float zscale,
+    float xoffset, float yoffset, float zoffset,
+    int rowPitch, int slicePitch,
+    int width, int height, int depth,
+    read_only global const float* verts, read_only global const uint* faces, uint triangleCount)
+{
+    float normal[3],e0[3],e1[3],e2[3];
+    const uint triangleIndex = get_global_id(0);
+
+    // due to quantization into grids, there can be more threads than triangles:
+    if (triangleIndex >= triangleCount)
+        return;
+        
+    uint A = faces[3*triangleIndex];
+    uint B = faces[3*triangleIndex+1];
+    uint C = faces[3*triangleIndex+2];
+    
+    float Ax = verts[A*3];
+    float Ay = verts[A*3+1];
+    float Az = verts[A*3+2];
+    
+    int iAx = (int) ((Ax + xoffset) * xscale);
+    int iAy = (int) ((Ay + yoffset) * yscale);
+    int iAz = (int) ((Az + zoffset) * zscale);
+    
+    float Bx = verts[B*3];
+    float By = verts[B*3+1];
+    float Bz = verts[B*3+2];
+
+    int iBx = (int) ((Bx + xoffset) * xscale);
+    int iBy = (int) ((By + yoffset) * yscale);
+    int iBz = (int) ((Bz + zoffset) * zscale);
+
+    float Cx = verts[C*3];
+    float Cy = verts[C*3+1];
+    float Cz = verts[C*3+2];
+
+    int iCx = (int) ((Cx + xoffset) * xscale);
+    int iCy = (int) ((Cy + yoffset) * yscale);
+    int iCz = (int) ((Cz + zoffset) * zscale);
+    
+    int minX = min(min(iAx, iBx), iCx);
+    int minY = min(min(iAy, iBy), iCy);
+    int minZ = min(min(iAz, iBz), iCz);
+    int maxX = max(max(iAx, iBx), iCx)+1;
+    int maxY = max(max(iAy, iBy), iCy)+1;
+    int maxZ = max(max(iAz, iBz), iCz)+1;
+    
+    minX = min(width-1,max(minX, 0));
+    minY = min(height-1,max(minY, 0));
+    minZ = min(depth-1,max(minZ, 0));
+    maxX = min(width-1,max(maxX, 0));
+    maxY = min(height-1,max(maxY, 0));
+    maxZ = min(depth-1,max(maxZ, 0));
+
+    float delta[3] = { 1.0/xscale, 1.0/yscale, 1.0/zscale };
+    float boxhalfsize[3] = { 0.5*delta[X], 0.5*delta[Y], 0.5*delta[Z] };
+    float triverts[3][3] = { { Ax, Ay, Az}, {Bx, By, Bz}, {Cx, Cy, Cz} };
+    float boxcenter[3] = { minX*delta[X] - xoffset, minY*delta[Y] - yoffset, minZ*delta[Z] - zoffset };
+
+    float v0[3] = {Ax, Ay, Az};
+    float v1[3] = {Bx, By, Bz};
+    float v2[3] = {Cx, Cy, Cz};
+    SUB(e0,v1,v0);
+    SUB(e1,v2,v1);
+    SUB(e2,v0,v2);
+    
+    float fe0[3] = {fabs(e0[X]), fabs(e0[Y]), fabs(e0[Z])};
+    float fe1[3] = {fabs(e1[X]), fabs(e1[Y]), fabs(e1[Z])};
+    float fe2[3] = {fabs(e2[X]), fabs(e2[Y]), fabs(e2[Z])};
+
+    SUB(v0,triverts[X],boxcenter);
+    SUB(v1,triverts[Y],boxcenter);
+    SUB(v2,triverts[Z],boxcenter);
+
+#ifdef PLANE_SPANS
+    normal[X] = e0[Y]*e1[Z] - e0[Z]*e1[Y];
+    normal[Y] = e0[Z]*e1[X] - e0[X]*e1[Z];
+    normal[Z] = e0[X]*e1[Y] - e0[Y]*e1[X];
+    float dA = normal[X]*Ax + normal[Y]*Ay + normal[Z]*Az;
+    float dB = normal[X]*Bx + normal[Y]*By + normal[Z]*Bz;
+    float dC = normal[X]*Cx + normal[Y]*Cy + normal[Z]*Cz;
+    float planeMin = min(min(dA, dB), dC), planeMax = max(max(dA, dB), dC);
+#endif
+
+    volume += minX + minY*rowPitch + (depth-1-minZ)*slicePitch;
+    for (int z = minZ; z <= maxZ; z++) {
+        global uchar* slice = volume;
+        for (int y = minY; y <= maxY; y++) {
+        
+            global uchar* row = slice;
+            int firstX = minX, lastX = maxX;
+#ifdef PLANE_SPANS
+            // Skip straight to the part of the row that the triangle's plane passes through.
+            if (!clipRowToPlane(normal, planeMin, planeMax, boxhalfsize, delta, xoffset, y*delta[Y] - yoffset, z*delta[Z] - zoffset, &firstX, &lastX))
+                lastX = firstX - 1;
+            row += firstX - minX;
+            v0[X] = Ax - (firstX*delta[X] - xoffset); v1[X] = Bx - (firstX*delta[X] - xoffset);  v2[X] = Cx - (firstX*delta[X] - xoffset);
+#endif
+            for (int x = firstX; x <= lastX; x++, row++) {
+                
+                // Do triangle ABC and voxel XYZ intersect?
+                // http://jgt.akpeters.com/papers/AkenineMoller01/tribox.html
+                
+                if (triBoxOverlap(boxhalfsize, v0, v1, v2, e0, e1, e2, fe0, fe1, fe2))
+                    *row = 255;
+                    
+                v0[X] -= delta[X]; v1[X] -= delta[X];  v2[X] -= delta[X];
+            }
+            slice += rowPitch;
+            
+            v0[X] = Ax-boxcenter[X]; v1[X] = Bx-boxcenter[X];  v2[X] = Cx-boxcenter[X];
+            v0[Y] -= delta[Y]; v1[Y] -= delta[Y];  v2[Y] -= delta[Y];
+        }
+        volume -= slicePitch;
+        
+        v0[Z] -= delta[Z]; v1[Z] -= delta[Z];  v2[Z] -= delta[Z];
+        v0[Y] = Ay-boxcenter[Y]; v1[Y] = By-boxcenter[Y];  v2[Y] = Cy-boxcenter[Y];
+    }
+}
+
+// Load-balanced path: a triangle's clamped AABB is cut into BRICK_SIZE^3 bricks,
+// count_bricks + scan_bricks turn that into a prefix sum, and voxelize_bricks
+// hands out one (triangle, brick) job per work-item.  Long helix triangles no
+// longer serialize a whole work-group behind a single thread.
+
+#define BRICK_SIZE 8
+
+inline void triangleBounds(
+    float xscale, float yscale, float zscale,
+    float xoffset, float yoffset, float zoffset,
+    int width, int height, int depth,
+    float v[3][3], int lo[3], int hi[3])
+{
+    float scale[3] = { xscale, yscale, zscale };
+    float offset[3] = { xoffset, yoffset, zoffset };
+    int extent[3] = { width, height, depth };
+    for (int c = 0; c < 3; c++) {
+        int a = (int) ((v[0][c] + offset[c]) * scale[c]);
+        int b = (int) ((v[1][c] + offset[c]) * scale[c]);
+        int d = (int) ((v[2][c] + offset[c]) * scale[c]);
+        lo[c] = min(extent[c]-1, max(min(min(a, b), d), 0));
+        hi[c] = min(extent[c]-1, max(max(max(a, b), d)+1, 0));
+    }
+}
+
+inline void fetchTriangle(
+    read_only global const float* verts, read_only global const uint* faces,
+    uint triangleIndex, float v[3][3])
+{
+    for (int i = 0; i < 3; i++) {
+        uint index = faces[3*triangleIndex+i];
+        v[i][X] = verts[index*3];
+        v[i][Y] = verts[index*3+1];
+        v[i][Z] = verts[index*3+2];
+    }
+}
+
+kernel void count_bricks(
+    global uint* brickCounts,
+    float xscale, float yscale, float zscale,
+    float xoffset, float yoffset, float zoffset,
+    int rowPitch, int slicePitch,
+    int width, int height, int depth,
+    read_only global const float* verts, read_only global const uint* faces, uint triangleCount)
+{
+    const uint triangleIndex = get_global_id(0);
+    if (triangleIndex >= triangleCount)
+        return;
+
+    float v[3][3];
+    int lo[3], hi[3];
+    fetchTriangle(verts, faces, triangleIndex, v);
+    triangleBounds(xscale, yscale, zscale, xoffset, yoffset, zoffset, width, height, depth, v, lo, hi);
+
+    brickCounts[triangleIndex] =
+        (hi[X]/BRICK_SIZE - lo[X]/BRICK_SIZE + 1) *
+        (hi[Y]/BRICK_SIZE - lo[Y]/BRICK_SIZE + 1) *
+        (hi[Z]/BRICK_SIZE - lo[Z]/BRICK_SIZE + 1);
+}
+
+// Launched as a single work-group; walks the counts in chunks of the group size
+// and writes the inclusive sums to brickOffsets[1..count], with brickOffsets[0] = 0.
+kernel void scan_bricks(
+    read_only global const uint* brickCounts,
+    global uint* brickOffsets,
+    uint triangleCount,
+    local uint* scratch)
+{
+    const uint lid = get_local_id(0);
+    const uint size = get_local_size(0);
+    uint carry = 0;
+
+    if (lid == 0)
+        brickOffsets[0] = 0;
+
+    for (uint base = 0; base < triangleCount; base += size) {
+        uint i = base + lid;
+        scratch[lid] = i < triangleCount ? brickCounts[i] : 0;
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for (uint stride = 1; stride < size; stride *= 2) {
+            uint addend = lid >= stride ? scratch[lid - stride] : 0;
+            barrier(CLK_LOCAL_MEM_FENCE);
+            scratch[lid] += addend;
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+
+        if (i < triangleCount)
+            brickOffsets[i+1] = carry + scratch[lid];
+        carry += scratch[size-1];
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+}
+
+kernel void voxelize_bricks(
+    write_only global uchar* volume,
+    float xscale, float yscale, float zscale,
+    float xoffset, float yoffset, float zoffset,
+    int rowPitch, int slicePitch,
+    int width, int height, int depth,
+    read_only global const float* verts, read_only global const uint* faces, uint triangleCount,
+    read_only global const uint* brickOffsets)
+{
+    const uint jobCount = brickOffsets[triangleCount];
+    float delta[3] = { 1.0/xscale, 1.0/yscale, 1.0/zscale };
+    float offset[3] = { xoffset, yoffset, zoffset };
+    float boxhalfsize[3] = { 0.5*delta[X], 0.5*delta[Y], 0.5*delta[Z] };
+
+    // Grid-stride loop so the launch size is independent of the job count.
+    for (uint job = get_global_id(0); job < jobCount; job += get_global_size(0)) {
+
+        // Last triangle whose first job is <= this one.
+        uint first = 0, last = triangleCount;
+        while (last - first > 1) {
+            uint middle = (first + last) / 2;
+            if (brickOffsets[middle] <= job) first = middle; else last = middle;
+        }
+        uint triangleIndex = first;
+        uint brick = job - brickOffsets[triangleIndex];
+
+        float v[3][3];
+        int lo[3], hi[3];
+        fetchTriangle(verts, faces, triangleIndex, v);
+        triangleBounds(xscale, yscale, zscale, xoffset, yoffset, zoffset, width, height, depth, v, lo, hi);
+
+        // Decode the brick coordinate (X fastest) and clip it to the triangle's bounds.
+        for (int c = 0; c < 3; c++) {
+            int firstBrick = lo[c] / BRICK_SIZE;
+            int count = hi[c] / BRICK_SIZE - firstBrick + 1;
+            int b = firstBrick + (c < 2 ? (int) (brick % count) : (int) brick);
+            brick /= count;
+            lo[c] = max(lo[c], b * BRICK_SIZE);
+            hi[c] = min(hi[c], b * BRICK_SIZE + BRICK_SIZE - 1);
+        }
+
+        float e0[3], e1[3], e2[3];
+        SUB(e0,v[1],v[0]);
+        SUB(e1,v[2],v[1]);
+        SUB(e2,v[0],v[2]);
+        float fe0[3] = {fabs(e0[X]), fabs(e0[Y]), fabs(e0[Z])};
+        float fe1[3] = {fabs(e1[X]), fabs(e1[Y]), fabs(e1[Z])};
+        float fe2[3] = {fabs(e2[X]), fabs(e2[Y]), fabs(e2[Z])};
+
+#ifdef PLANE_SPANS
+        float normal[3] = { e0[Y]*e1[Z] - e0[Z]*e1[Y], e0[Z]*e1[X] - e0[X]*e1[Z], e0[X]*e1[Y] - e0[Y]*e1[X] };
+        float d0 = normal[X]*v[0][X] + normal[Y]*v[0][Y] + normal[Z]*v[0][Z];
+        float d1 = normal[X]*v[1][X] + normal[Y]*v[1][Y] + normal[Z]*v[1][Z];
+        float d2 = normal[X]*v[2][X] + normal[Y]*v[2][Y] + normal[Z]*v[2][Z];
+        float planeMin = min(min(d0, d1), d2), planeMax = max(max(d0, d1), d2);
+#endif
+
+        for (int z = lo[Z]; z <= hi[Z]; z++) {
+            global uchar* slice = volume + (depth-1-z)*slicePitch;
+            for (int y = lo[Y]; y <= hi[Y]; y++) {
+                global uchar* row = slice + y*rowPitch;
+                int firstX = lo[X], lastX = hi[X];
+#ifdef PLANE_SPANS
+                if (!clipRowToPlane(normal, planeMin, planeMax, boxhalfsize, delta, xoffset, y*delta[Y] - yoffset, z*delta[Z] - zoffset, &firstX, &lastX))
+                    continue;
+#endif
+                for (int x = firstX; x <= lastX; x++) {
+                    float boxcenter[3] = { x*delta[X] - offset[X], y*delta[Y] - offset[Y], z*delta[Z] - offset[Z] };
+                    float v0[3], v1[3], v2[3];
+                    SUB(v0,v[0],boxcenter);
+                    SUB(v1,v[1],boxcenter);
+                    SUB(v2,v[2],boxcenter);
+                    if (triBoxOverlap(boxhalfsize, v0, v1, v2, e0, e1, e2, fe0, fe1, fe2))
+                        row[x] = 255;
+                }
+            }
+        }
+    }
+}
+
+// Thin 6-separating surface: each triangle is projected along its dominant axis and every
+// voxel column whose center passes the projected edge tests (pushed out by the 6-separating
+// offset) gets the one voxel where the triangle's plane crosses it.  Works in voxel units,
+// where voxel i is centered at i.  Shares the voxelize argument layout.
+//
+// The plane is in double where the device has it: a sliver's normal is mostly rounding error
+// in single precision, and a wrong normal puts its voxels anywhere along the columns.
+// Devices without cl_khr_fp64 fall back to float.
+#ifdef cl_khr_fp64
+#pragma OPENCL EXTENSION cl_khr_fp64: enable
+typedef double plane_t;
+#else
+typedef float plane_t;
+#endif
+
+kernel void voxelize_thin(
+    write_only global uchar* volume,
+    float xscale, float yscale, float zscale,
+    float xoffset, float yoffset, float zoffset,
+    int rowPitch, int slicePitch,
+    int width, int height, int depth,
+    read_only global const float* verts, read_only global const uint* faces, uint triangleCount)
+{
+    const uint triangleIndex = get_global_id(0);
+    if (triangleIndex >= triangleCount)
+        return;
+
+    float scale[3] = { xscale, yscale, zscale };
+    float offset[3] = { xoffset, yoffset, zoffset };
+    int extent[3] = { width, height, depth };
+
+    float p[3][3];
+    fetchTriangle(verts, faces, triangleIndex, p);
+    for (int i = 0; i < 3; i++)
+        for (int c = 0; c < 3; c++)
+            p[i][c] = (p[i][c] + offset[c]) * scale[c];
+
+    plane_t e0[3], e1[3];
+    for (int c = 0; c < 3; c++) {
+        e0[c] = (plane_t) p[1][c] - (plane_t) p[0][c];
+        e1[c] = (plane_t) p[2][c] - (plane_t) p[0][c];
+    }
+    plane_t n[3] = { e0[Y]*e1[Z] - e0[Z]*e1[Y], e0[Z]*e1[X] - e0[X]*e1[Z], e0[X]*e1[Y] - e0[Y]*e1[X] };
+
+    // Dominant axis k; (u, w, k) keeps the handedness of (x, y, z).
+    int k = fabs(n[X]) >= fabs(n[Y]) ? (fabs(n[X]) >= fabs(n[Z]) ? X : Z) : (fabs(n[Y]) >= fabs(n[Z]) ? Y : Z);
+    if (n[k] == 0)
+        return;
+    int u = (k + 1) % 3, w = (k + 2) % 3;
+    float facing = n[k] > 0 ? 1.0f : -1.0f;
+
+    float edgeU[3], edgeW[3], edgeD[3];
+    for (int e = 0; e < 3; e++) {
+        int f = (e + 1) % 3;
+        edgeU[e] = -(p[f][w] - p[e][w]) * facing;
+        edgeW[e] = (p[f][u] - p[e][u]) * facing;
+        edgeD[e] = -(edgeU[e]*p[e][u] + edgeW[e]*p[e][w]) + 0.5f * max(fabs(edgeU[e]), fabs(edgeW[e]));
+    }
+    plane_t d = n[X]*p[0][X] + n[Y]*p[0][Y] + n[Z]*p[0][Z];
+
+    int lo[3], hi[3];
+    for (int c = 0; c < 3; c++) {
+        lo[c] = max(0, (int) ceil(min(min(p[0][c], p[1][c]), p[2][c]) - 0.5f));
+        hi[c] = min(extent[c]-1, (int) floor(max(max(p[0][c], p[1][c]), p[2][c]) + 0.5f));
+    }
+
+    int voxel[3];
+    for (int cw = lo[w]; cw <= hi[w]; cw++) {
+        for (int cu = lo[u]; cu <= hi[u]; cu++) {
+            if (edgeU[0]*cu + edgeW[0]*cw + edgeD[0] < 0 ||
+                edgeU[1]*cu + edgeW[1]*cw + edgeD[1] < 0 ||
+                edgeU[2]*cu + edgeW[2]*cw + edgeD[2] < 0)
+                continue;
+
+            int ck = (int) floor((d - n[u]*cu - n[w]*cw) / n[k] + (plane_t) 0.5);
+            if (ck < lo[k] || ck > hi[k])
+                continue;
+
+            voxel[u] = cu;
+            voxel[w] = cw;
+            voxel[k] = ck;
+            volume[voxel[X] + voxel[Y]*rowPitch + (depth-1-voxel[Z])*slicePitch] = 255;
+        }
+    }
+}
+
+// Dirty-brick clears: rather than zeroing the whole volume every frame, mark_bricks stamps
+// every BRICK_SIZE^3 brick overlapped by a triangle's bounds with the current epoch, and
+// clear_bricks later zeroes only the bricks that carry the stamp of the previous pass over
+// the same volume.  Shares the count_bricks argument layout, plus the epoch.
+kernel void mark_bricks(
+    global uint* stamps,
+    float xscale, float yscale, float zscale,
+    float xoffset, float yoffset, float zoffset,
+    int rowPitch, int slicePitch,
+    int width, int height, int depth,
+    read_only global const float* verts, read_only global const uint* faces, uint triangleCount,
+    uint epoch)
+{
+    const uint triangleIndex = get_global_id(0);
+    if (triangleIndex >= triangleCount)
+        return;
+
+    float v[3][3];
+    int lo[3], hi[3];
+    fetchTriangle(verts, faces, triangleIndex, v);
+    triangleBounds(xscale, yscale, zscale, xoffset, yoffset, zoffset, width, height, depth, v, lo, hi);
+
+    int bricksX = (width + BRICK_SIZE - 1) / BRICK_SIZE;
+    int bricksY = (height + BRICK_SIZE - 1) / BRICK_SIZE;
+    for (int bz = lo[Z]/BRICK_SIZE; bz <= hi[Z]/BRICK_SIZE; bz++)
+        for (int by = lo[Y]/BRICK_SIZE; by <= hi[Y]/BRICK_SIZE; by++)
+            for (int bx = lo[X]/BRICK_SIZE; bx <= hi[X]/BRICK_SIZE; bx++)
+                stamps[bx + bricksX * (by + bricksY * bz)] = epoch;
+}
+
+// One work-item per row of every brick; rows of bricks without the given stamp are left alone.
+kernel void clear_bricks(
+    write_only global uchar* volume,
+    read_only global const uint* stamps,
+    uint epoch,
+    int rowPitch, int slicePitch,
+    int width, int height, int depth)
+{
+    const int bricksX = (width + BRICK_SIZE - 1) / BRICK_SIZE;
+    const int bricksY = (height + BRICK_SIZE - 1) / BRICK_SIZE;
+    const int bricksZ = (depth + BRICK_SIZE - 1) / BRICK_SIZE;
+    const uint brick = get_global_id(0) / (BRICK_SIZE * BRICK_SIZE);
+    const uint row = get_global_id(0) % (BRICK_SIZE * BRICK_SIZE);
+    if (brick >= (uint) (bricksX * bricksY * bricksZ) || stamps[brick] != epoch)
+        return;
+
+    int x = (brick % bricksX) * BRICK_SIZE;
+    int y = (brick / bricksX % bricksY) * BRICK_SIZE + row % BRICK_SIZE;
+    int z = (brick / bricksX / bricksY) * BRICK_SIZE + row / BRICK_SIZE;
+    if (y >= height || z >= depth)
+        return;
+
+    global uchar* dest = volume + y*rowPitch + (depth-1-z)*slicePitch;
+    for (int end = min(x + BRICK_SIZE, width); x < end; x++)
+        dest[x] = 0;
+}
+
+// Jump flooding: every voxel keeps the nearest surface voxel it has heard of, packed as
+// x | y << 10 | z << 20, or NO_SEED.  Each pass looks at the 26 voxels step away, and the
+// steps halve from half the grid down to 1, so log2(N) passes reach every voxel; one more
+// pass at step 1 mends most of the voxels that the coarse steps got slightly wrong
+// [Rong & Tan, "Jump Flooding in GPU with Applications to Voronoi Diagram and Distance
+// Transform"].  Seeds are x-fastest and not flipped; one work-item per voxel throughout.
+#define NO_SEED 0xffffffffu
+#define SEED_X(s) ((int) ((s) & 1023))
+#define SEED_Y(s) ((int) (((s) >> 10) & 1023))
+#define SEED_Z(s) ((int) ((s) >> 20))
+
+kernel void jfa_seed(
+    read_only global const uchar* volume,
+    write_only global uint* seeds,
+    int rowPitch, int slicePitch,
+    int width, int height, int depth)
+{
+    const uint i = get_global_id(0);
+    if (i >= (uint) (width * height * depth))
+        return;
+
+    int x = i % width;
+    int y = i / width % height;
+    int z = i / width / height;
+    seeds[i] = volume[x + y*rowPitch + (depth-1-z)*slicePitch] ? (uint) (x | y << 10 | z << 20) : NO_SEED;
+}
+
+kernel void jfa_step(
+    read_only global const uint* src,
+    write_only global uint* dest,
+    int step,
+    int width, int height, int depth)
+{
+    const uint i = get_global_id(0);
+    if (i >= (uint) (width * height * depth))
+        return;
+
+    int x = i % width;
+    int y = i / width % height;
+    int z = i / width / height;
+
+    uint best = src[i];
+    int bestDistance = INT_MAX;
+    if (best != NO_SEED) {
+        int dx = SEED_X(best) - x, dy = SEED_Y(best) - y, dz = SEED_Z(best) - z;
+        bestDistance = dx*dx + dy*dy + dz*dz;
+    }
+
+    for (int nz = z - step; nz <= z + step; nz += step) {
+        if (nz < 0 || nz >= depth)
+            continue;
+        for (int ny = y - step; ny <= y + step; ny += step) {
+            if (ny < 0 || ny >= height)
+                continue;
+            for (int nx = x - step; nx <= x + step; nx += step) {
+                if (nx < 0 || nx >= width)
+                    continue;
+                uint seed = src[nx + width * (ny + height * nz)];
+                if (seed == NO_SEED)
+                    continue;
+                int dx = SEED_X(seed) - x, dy = SEED_Y(seed) - y, dz = SEED_Z(seed) - z;
+                int distance = dx*dx + dy*dy + dz*dz;
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = seed;
+                }
+            }
+        }
+    }
+    dest[i] = best;
+}
+
+// Distances in voxels, laid out and flipped like the surface volume; MAXFLOAT where the
+// volume has no surface at all.
+kernel void jfa_distance(
+    read_only global const uint* seeds,
+    write_only global float* distances,
+    int rowPitch, int slicePitch,
+    int width, int height, int depth)
+{
+    const uint i = get_global_id(0);
+    if (i >= (uint) (width * height * depth))
+        return;
+
+    int x = i % width;
+    int y = i / width % height;
+    int z = i / width / height;
+
+    uint seed = seeds[i];
+    float distance = MAXFLOAT;
+    if (seed != NO_SEED) {
+        int dx = SEED_X(seed) - x, dy = SEED_Y(seed) - y, dz = SEED_Z(seed) - z;
+        distance = sqrt((float) (dx*dx + dy*dy + dz*dz));
+    }
+    distances[x + y*rowPitch + (depth-1-z)*slicePitch] = distance;
+}
+
+--------- Scratch Space ---------
+
+kernel void voxelze(write_only image3d_t volume)
+{
+    const int x = get_global_id(0);
+    const int y = get_global_id(1);
+    const int z = get_global_id(2);
+}
+    
+kernel void voxelize(
+    write_only image3d_t volume,
+    read_only global const float3* verts,
+    read_only global const ushort3* faces)
+{
+}
+
+kernel void fast_clear(
+    write_only global uchar* volume,
+    uint width, uint height, uint depth,
+    uint rowPitch, uint slicePitch)
+{
+    int x = get_global_id(0);
+    int y = get_global_id(1);
+    int z = get_global_id(2);
+
+    // due to quantization into grids, there can be more threads than pixels:
+    if (x >= width || y >= height || z >= depth)
+        return;
+    
+    volume[x + y*rowPitch + z*slicePitch] = 0;
+}
+
+kernel void clear(
+    write_only global uchar* volume,
+    uint width, uint height, uint depth,
+    uint rowPitch, uint slicePitch)
+{
+    int x = get_global_id(0);
+    int y = get_global_id(1);
+
+    // due to quantization into grids, there can be more threads than pixels:
+    if (x >= width || y >= height)
+        return;
+    
+    // walk across slices:
+    for (int z = 0; z < depth; ++z)
+        volume[x + y*rowPitch + z*slicePitch] = 0;
+}
@@ -1,235 +1,1037 @@
-#include "Common.hpp"
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <memory.h>
-#include <glew.h>
-#include <pez.h>
-#include <glsw.h>
-#include <CL/opencl.h>
-
-using namespace vmath;
-
-#define MAX_MESH_COUNT 16
-#define DIRECT_TEXTURE_WRITES
-
-static cl_context context;
-static cl_program program;
-static cl_int err;
-static cl_kernel voxelizeKernel, clearKernel;
-static cl_command_queue commandQueue;
-static cl_device_id deviceId;
-static cl_mem inBuffers[1+MAX_MESH_COUNT*2];
-static unsigned int triangleCount[MAX_MESH_COUNT];
-static unsigned int meshCount = 0;
-static SurfacePod* VolumeSurface;
-
-static cl_platform_id GpuGetPlatform();
-
-void __stdcall handle_error(const char* errinfo, const void* private_info, size_t cb, void* user_data)
-{
-    PezFatalError(errinfo);
-}
-
-void InitOpenCL(SurfacePod& destination)
-{
-    cl_platform_id platformId = GpuGetPlatform();
-    const char* kernelSource;
-    cl_context_properties glContext, hdc;
-    char version_string[128] = {0}, extensions[256] = {0};
-    int maxSize;
-
-    VolumeSurface = &destination;
-
-    clGetDeviceIDs(platformId, CL_DEVICE_TYPE_GPU, 1, &deviceId, NULL);
-
-    clGetDeviceInfo(deviceId, CL_DEVICE_VERSION, sizeof(version_string), &version_string[0], NULL);
-    clGetDeviceInfo(deviceId, CL_DEVICE_EXTENSIONS, sizeof(extensions), &extensions[0], NULL);
-    clGetDeviceInfo(deviceId, CL_DEVICE_MAX_WORK_GROUP_SIZE, sizeof(maxSize), &maxSize, NULL);
-    PezDebugString("%s\n%d max work items\n%s\n", version_string, maxSize, extensions);
-
-    PezGetContext((int**) &glContext, (int**) &hdc);
-
-    cl_context_properties props[] = {
-        CL_GL_CONTEXT_KHR, glContext,
-        CL_WGL_HDC_KHR, hdc,
-        0
-    };
-    
-    context = clCreateContext(props, 1, &deviceId, handle_error, NULL, 0);
-
-    PezCheckCondition(context != 0, "Failed to create OpenCL context.\n");
-    
-    err = 0;
-    inBuffers[0] = clCreateFromGLBuffer(context, CL_MEM_WRITE_ONLY, VolumeSurface->ColorTexture, &err);
-    switch (err)
-    {
-        case CL_INVALID_CONTEXT:   PezFatalError("OpenCL invalid context."); break;
-        case CL_INVALID_VALUE:     PezFatalError("OpenCL invalid value."); break;
-        case CL_INVALID_MIP_LEVEL: PezFatalError("OpenCL invalid mip level."); break;
-        case CL_INVALID_GL_OBJECT: PezFatalError("OpenCL invalid GL object."); break;
-        case CL_INVALID_IMAGE_FORMAT_DESCRIPTOR: PezFatalError("OpenCL image format desc."); break;
-        case CL_INVALID_OPERATION:  PezFatalError("OpenCL invalid operation."); break;
-        case CL_OUT_OF_RESOURCES:   PezFatalError("OpenCL out of resources."); break;
-        case CL_OUT_OF_HOST_MEMORY: PezFatalError("OpenCL out of host memory."); break;
-        case CL_SUCCESS: break;
-        default: PezFatalError("OpenCL error.");
-    }
-    
-    kernelSource = glswGetShader("Kernels.Surfaces");
-    program = clCreateProgramWithSource(context, 1, &kernelSource, NULL, NULL);
-    
-    err = clBuildProgram(program, 0, NULL, "-cl-fast-relaxed-math", NULL, NULL);
-    if (err != CL_SUCCESS) {
-        size_t len;
-        char buffer[2048] = {0};
-        memset(buffer, 0, sizeof(buffer));
-        clGetProgramBuildInfo(program, deviceId, CL_PROGRAM_BUILD_LOG, sizeof(buffer), buffer, &len);
-        PezFatalError("Error: Failed to build OpenCL kernel\n%s\n", buffer);
-    }
-    
-    
-    voxelizeKernel = clCreateKernel(program, "voxelize", NULL);
-    clearKernel = clCreateKernel(program, "fast_clear", NULL);
-    commandQueue = clCreateCommandQueue(context, deviceId, 0, NULL);
-
-    destination.ComputeBuffer = clCreateBuffer(context, CL_MEM_WRITE_ONLY, destination.ByteCount, NULL, &err);
-    PezCheckCondition(!err, "Failed to create staging buffer for 3D writes.\n");
-
-    void* empty = calloc(destination.ByteCount, 1);
-    destination.ClearBuffer = clCreateBuffer(context, CL_MEM_COPY_HOST_PTR, destination.ByteCount, empty, &err);
-    free(empty);
-    PezCheckCondition(!err, "Failed to create clear buffer.\n");
-}
-
-void AddOpenCL(const MeshPod& mesh)
-{
-    inBuffers[1+2*meshCount] = clCreateFromGLBuffer(context, CL_MEM_READ_ONLY, mesh.PositionsBuffer, &err);
-    PezCheckCondition(err == 0, "Unable to create OpenCL point buffer");
-
-    inBuffers[2+2*meshCount] = clCreateFromGLBuffer(context, CL_MEM_READ_ONLY, mesh.TriangleBuffer, &err);
-    PezCheckCondition(err == 0, "Unable to create OpenCL triangle buffer");
-
-    triangleCount[meshCount++] = mesh.TriangleCount;
-}
-
-void RunOpenCL(Point3 minCorner, Point3 maxCorner)
-{
-    size_t localSize;
-    clGetKernelWorkGroupInfo(voxelizeKernel, deviceId, CL_KERNEL_WORK_GROUP_SIZE, sizeof(int), &localSize, 0) ;
-
-    err = clEnqueueAcquireGLObjects(commandQueue, 1+2*meshCount, &inBuffers[0], 0,0,0);
-    PezCheckCondition(err == 0, "Unable to lock vertex buffers for OpenCL\n");
-
-    float xscale = VolumeSurface->Width / (maxCorner[0] - minCorner[0]);
-    float yscale = VolumeSurface->Height / (maxCorner[1] - minCorner[1]);
-    float zscale = VolumeSurface->Depth / (maxCorner[2] - minCorner[2]);
-    float xoffset = -minCorner[0];
-    float yoffset = -minCorner[1];
-    float zoffset = -minCorner[2];
-
-#ifdef DIRECT_TEXTURE_WRITES
-    err |= clEnqueueCopyBuffer(commandQueue, (cl_mem) VolumeSurface->ClearBuffer, (cl_mem) inBuffers[0], 0, 0, VolumeSurface->ByteCount, 0, 0, 0);
-    err |= clSetKernelArg(voxelizeKernel, 0, sizeof(cl_mem), &inBuffers[0]);
-#else
-    err |= clEnqueueCopyBuffer(commandQueue, (cl_mem) VolumeSurface->ClearBuffer, (cl_mem) VolumeSurface->ComputeBuffer, 0, 0, VolumeSurface->ByteCount, 0, 0, 0);
-    err |= clSetKernelArg(voxelizeKernel, 0, sizeof(cl_mem), &VolumeSurface->ComputeBuffer);
-#endif
-
-    err |= clSetKernelArg(voxelizeKernel, 1, sizeof(float), &xscale);
-    err |= clSetKernelArg(voxelizeKernel, 2, sizeof(float), &yscale);
-    err |= clSetKernelArg(voxelizeKernel, 3, sizeof(float), &zscale);
-    err |= clSetKernelArg(voxelizeKernel, 4, sizeof(float), &xoffset);
-    err |= clSetKernelArg(voxelizeKernel, 5, sizeof(float), &yoffset);
-    err |= clSetKernelArg(voxelizeKernel, 6, sizeof(float), &zoffset);
-    err |= clSetKernelArg(voxelizeKernel, 7, sizeof(int), &VolumeSurface->RowPitch);
-    err |= clSetKernelArg(voxelizeKernel, 8, sizeof(int), &VolumeSurface->SlicePitch);
-    err |= clSetKernelArg(voxelizeKernel, 9, sizeof(int), &VolumeSurface->Width);
-    err |= clSetKernelArg(voxelizeKernel, 10, sizeof(int), &VolumeSurface->Height);
-    err |= clSetKernelArg(voxelizeKernel, 11, sizeof(int), &VolumeSurface->Depth);
-    PezCheckCondition(!err, "Unable to set arguments 0-11 on OpenCL kernel");
-
-    size_t localWorkSize[] = { localSize };
-
-    for (unsigned int meshIndex = 0; meshIndex < meshCount; ++meshIndex)
-    {
-        err |= clSetKernelArg(voxelizeKernel, 12, sizeof(cl_mem), (void*) &inBuffers[1+meshIndex*2]);
-        err |= clSetKernelArg(voxelizeKernel, 13, sizeof(cl_mem), (void*) &inBuffers[2+meshIndex*2]);
-        err |= clSetKernelArg(voxelizeKernel, 14, sizeof(int), (void*) &triangleCount[meshIndex]);
-        PezCheckCondition(err == 0, "Unable to set arguments 12-14 on OpenCL kernel");
-
-        size_t globalWorkSize[] = { snap(triangleCount[meshIndex], localWorkSize[0]) };
-
-        err = clEnqueueNDRangeKernel(commandQueue, voxelizeKernel, 1, NULL, globalWorkSize, localWorkSize, 0, NULL, NULL);
-        PezCheckCondition(err != CL_INVALID_KERNEL_ARGS, "Unable to enqueue 'Voxelize' kernel: invalid kernel args\n");
-        PezCheckCondition(err == 0, "Unable to enqueue OpenCL kernel: error code is %d=%8.8x\n", err, err);
-    }
-
-#ifndef DIRECT_TEXTURE_WRITES
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, VolumeSurface->Pbo);
-    void* pDest = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
-    PezCheckCondition(glGetError() == GL_NO_ERROR, "Unable to map OpenGL PBO.\n");
-    err = clEnqueueReadBuffer(commandQueue, (cl_mem) VolumeSurface->ComputeBuffer, CL_TRUE, 0, VolumeSurface->ByteCount, pDest, 0, 0, 0);
-    PezCheckCondition(!err, "Unable to copy buffer: error code is %d\n", err);
-    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
-    glBindTexture(GL_TEXTURE_3D, VolumeSurface->ColorTexture);
-    glTexImage3D(GL_TEXTURE_3D, 0, GL_R8, VolumeSurface->Width, VolumeSurface->Height, VolumeSurface->Depth, 0, GL_RED, GL_UNSIGNED_BYTE, 0);
-    glBindTexture(GL_TEXTURE_3D, 0);
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
-    PezCheckCondition(glGetError() == GL_NO_ERROR, "Unable to copy PBO to OpenGL Texture.\n");
-#endif
-
-    err = clEnqueueReleaseGLObjects(commandQueue, 1+2*meshCount, &inBuffers[0], 0,0,0);
-    PezCheckCondition(err == 0, "Unable to release buffers back to OpenGL");
-
-    // Yes, we're clearing TWICE when using direct texture writes.  Works around a driver issue.
-#ifdef DIRECT_TEXTURE_WRITES
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, VolumeSurface->ClearPbo);
-    glBindTexture(GL_TEXTURE_3D, VolumeSurface->ColorTexture);
-    glTexImage3D(GL_TEXTURE_3D, 0, GL_R8, VolumeSurface->Width, VolumeSurface->Height, VolumeSurface->Depth, 0, GL_RED, GL_UNSIGNED_BYTE, 0);
-    glBindTexture(GL_TEXTURE_3D, 0);
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
-    PezCheckCondition(glGetError() == GL_NO_ERROR, "Unable to copy PBO to OpenGL Texture.\n");
-#endif
-}
-
-void ClearOpenCL()
-{
-}
-
-static cl_platform_id GpuGetPlatform()
-{
-    char chBuffer[1024];
-    cl_uint num_platforms; 
-    cl_platform_id* clPlatformIDs;
-    cl_uint i;
-    cl_platform_id id;
-    cl_int err;
-    
-    err = clGetPlatformIDs (0, NULL, &num_platforms);
-    if (err != CL_SUCCESS) {
-        puts("Error with clGetPlatformIDs.\n\n");
-        exit(1);
-    }
-    
-    if (num_platforms == 0) {
-        puts("No OpenCL platform found.\n\n");
-        exit(1);
-    }
-    
-    clPlatformIDs = (cl_platform_id*) malloc(num_platforms * sizeof(cl_platform_id));
-    clGetPlatformIDs(num_platforms, clPlatformIDs, NULL);
-    
-    id = clPlatformIDs[0];
-    
-    for (i = 0; i < num_platforms; ++i) {
-        err = clGetPlatformInfo(clPlatformIDs[i], CL_PLATFORM_NAME, 1024, &chBuffer, NULL);
-        if (err == CL_SUCCESS && strstr(chBuffer, "NVIDIA")) {
-            id = clPlatformIDs[i];
-            break;
-        }
-    }
-    
-    free(clPlatformIDs);
-    return id;
-}
+#include "Common.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <memory.h>
+#include <algorithm>
+#include <glew.h>
+#include <pez.h>
+#include <glsw.h>
+#include <CL/opencl.h>
+
+using namespace vmath;
+
+#define DIRECT_TEXTURE_WRITES // kernels write the shared PBO rather than a staging buffer
+#define BRICK_JOBS
+#define PLANE_SPANS
+// #define THIN_SURFACE
+
+#ifdef THIN_SURFACE
+// The thin kernel only evaluates one plane per voxel column, so whole triangles are cheap
+// enough per work-item and the brick jobs are skipped.
+#undef BRICK_JOBS
+#endif
+
+static cl_context context;
+static cl_program program;
+static cl_int err;
+static cl_kernel voxelizeKernel, clearKernel, markKernel;
+static cl_command_queue commandQueue;
+static cl_device_id deviceId;
+static SurfacePod* VolumeSurface;
+static bool implicitSync;
+
+// Bricks that a pass may have written carry that pass's epoch, so the next pass over the same
+// buffer only clears those.  Epoch 0 means the buffer has never been written or cleared.
+struct DirtyBricks {
+    cl_mem Stamps;
+    cl_uint Epoch;
+};
+
+// OpenCL voxelizes into one volume while OpenGL ray casts the other.  Each volume's PBO is
+// shared with OpenCL; once the event of its release has completed, the PBO is unpacked into
+// the volume's texture and the two swap roles.
+struct VolumeSlot {
+    SurfacePod* Surface;
+    cl_mem Pbo;
+    cl_event Started;
+    cl_event Done;
+    bool Unpacked;
+    DirtyBricks Bricks;
+};
+static VolumeSlot volumeSlots[2];
+static int writeSlot = 0;
+static DirtyBricks stagingBricks;
+static size_t brickCount;
+
+// Registered meshes are packed into one vertex arena and one index arena, with each mesh's
+// indices rebased onto its first arena vertex, so a single dispatch voxelizes all of them.
+// Positions are copied out of the shared GL buffers every frame; the index arena is only
+// rebuilt when meshes come or go.  Mesh ids are indices into meshes, and are reused.
+struct ArenaMesh {
+    cl_mem Positions;
+    std::vector<cl_uint> Indices;
+    unsigned int VertexCount;
+    unsigned int FirstVertex;
+    bool Live;
+};
+static std::vector<ArenaMesh> meshes;
+static std::vector<cl_mem> sharedBuffers;   // the target PBO, then every live mesh's positions
+static std::vector<cl_uint> arenaIndices;
+static cl_mem arenaPositions, arenaFaces;
+static size_t vertexCapacity = 0, triangleCapacity = 0;
+static unsigned int arenaVertexCount = 0, arenaTriangleCount = 0;
+static bool arenaStale = true;
+
+// Without OpenGL, the voxelizer writes a plain buffer that is read back on demand.
+static SurfacePod headlessSurface;
+static DirtyBricks headlessBricks;
+
+// Jump-flood distances: while enabled, every pass also floods the volume it voxelized and
+// leaves the distance to the nearest surface voxel in distanceBuffer, a float per voxel laid
+// out like the volume.  The seed buffers are ping-ponged between the passes.
+static cl_kernel seedKernel, jumpKernel, distanceKernel;
+static cl_mem seedBuffers[2], distanceBuffer;
+static bool distances = false;
+
+#ifdef BRICK_JOBS
+static cl_kernel countKernel, scanKernel, bricksKernel;
+static cl_mem brickCounts, brickOffsets;
+static size_t bricksGlobalSize;
+#endif
+
+// Profiling: while enabled, every enqueued command carries an event, tagged with the step it
+// belongs to.  Events are harvested once they complete and folded into per-step totals.
+enum ProfileStep {
+    StepGather, StepClear, StepMark, StepCount, StepScan, StepVoxelize, StepJumpFlood,
+    StepAcquire, StepCopy, StepRelease, StepRead, StepCountOf
+};
+static const char* profileNames[StepCountOf] = {
+    "gather", "clear", "mark_bricks", "count_bricks", "scan_bricks", "voxelize", "jump_flood",
+    "acquire", "copy", "release", "read"
+};
+struct PendingEvent {
+    ProfileStep Step;
+    cl_event Event;
+};
+static bool profiling = false;
+static std::vector<PendingEvent> pendingEvents;
+static std::vector<ProfilePod> profile;
+
+void CL_CALLBACK handle_error(const char* errinfo, const void* private_info, size_t cb, void* user_data)
+{
+    PezFatalError(errinfo);
+}
+
+// Picks the OpenCL device.  SURFACEVOXELS_CL_DEVICE_TYPE (gpu, cpu, accelerator or all)
+// overrides the requested type, and SURFACEVOXELS_CL_DEVICE picks the first device whose
+// platform or device name contains it.  Otherwise NVIDIA platforms are preferred.  When no
+// device has the requested type, any device will do, so that CPU implementations such as
+// PoCL can stand in on hosts without a GPU.
+static cl_device_id SelectDevice(cl_device_type type, cl_platform_id* selectedPlatform)
+{
+    const char* typeName = getenv("SURFACEVOXELS_CL_DEVICE_TYPE");
+    if (typeName) {
+        if (!strcmp(typeName, "gpu")) type = CL_DEVICE_TYPE_GPU;
+        else if (!strcmp(typeName, "cpu")) type = CL_DEVICE_TYPE_CPU;
+        else if (!strcmp(typeName, "accelerator")) type = CL_DEVICE_TYPE_ACCELERATOR;
+        else if (!strcmp(typeName, "all")) type = CL_DEVICE_TYPE_ALL;
+        else PezFatalError("Unknown SURFACEVOXELS_CL_DEVICE_TYPE '%s'.\n", typeName);
+    }
+    const char* name = getenv("SURFACEVOXELS_CL_DEVICE");
+
+    cl_uint platformCount = 0;
+    clGetPlatformIDs(0, NULL, &platformCount);
+    PezCheckCondition(platformCount > 0, "No OpenCL platform found.\n");
+    std::vector<cl_platform_id> platforms(platformCount);
+    clGetPlatformIDs(platformCount, &platforms[0], NULL);
+
+    cl_device_type types[] = { type, CL_DEVICE_TYPE_ALL };
+    for (int pass = 0; pass < 2; ++pass) {
+        cl_device_id best = 0;
+        bool preferred = false;
+        for (cl_uint p = 0; p < platformCount; ++p) {
+            char platformName[256] = {0};
+            clGetPlatformInfo(platforms[p], CL_PLATFORM_NAME, sizeof(platformName), platformName, NULL);
+
+            cl_uint deviceCount = 0;
+            if (clGetDeviceIDs(platforms[p], types[pass], 0, NULL, &deviceCount) != CL_SUCCESS || !deviceCount)
+                continue;
+            std::vector<cl_device_id> devices(deviceCount);
+            clGetDeviceIDs(platforms[p], types[pass], deviceCount, &devices[0], NULL);
+
+            for (cl_uint d = 0; d < deviceCount; ++d) {
+                char deviceName[256] = {0};
+                clGetDeviceInfo(devices[d], CL_DEVICE_NAME, sizeof(deviceName), deviceName, NULL);
+                if (name) {
+                    if (strstr(platformName, name) || strstr(deviceName, name)) {
+                        *selectedPlatform = platforms[p];
+                        return devices[d];
+                    }
+                    continue;
+                }
+                if (!best || (!preferred && strstr(platformName, "NVIDIA"))) {
+                    best = devices[d];
+                    preferred = strstr(platformName, "NVIDIA") != 0;
+                    *selectedPlatform = platforms[p];
+                }
+            }
+        }
+        if (best)
+            return best;
+    }
+
+    if (name)
+        PezFatalError("No OpenCL device matches '%s'.\n", name);
+    PezFatalError("No OpenCL device found.\n");
+    return 0;
+}
+
+// Program binaries are cached on disk so that only the first run on a given device and
+// driver pays for the source build, which takes seconds on some CPU runtimes.  The file
+// name comes from a hash of everything the binary depends on; the full key is stored in
+// the file too, and anything that does not match it exactly is rebuilt from source.
+// SURFACEVOXELS_CL_CACHE names the cache folder, or turns the cache off when empty.
+static std::string ProgramCacheKey(const char* source, const char* buildOptions, std::string* path)
+{
+    const char* folder = getenv("SURFACEVOXELS_CL_CACHE");
+    if (!folder)
+        folder = ".";
+    if (!*folder)
+        return std::string();
+
+    char deviceName[256] = {0}, driverVersion[128] = {0}, deviceVersion[128] = {0};
+    clGetDeviceInfo(deviceId, CL_DEVICE_NAME, sizeof(deviceName), deviceName, NULL);
+    clGetDeviceInfo(deviceId, CL_DRIVER_VERSION, sizeof(driverVersion), driverVersion, NULL);
+    clGetDeviceInfo(deviceId, CL_DEVICE_VERSION, sizeof(deviceVersion), deviceVersion, NULL);
+
+    // FNV-1a over the source; the rest of the key is short enough to keep verbatim.
+    unsigned long long sourceHash = 14695981039346656037ull;
+    for (const char* c = source; *c; ++c)
+        sourceHash = (sourceHash ^ (unsigned char) *c) * 1099511628211ull;
+
+    char hashText[17];
+    sprintf(hashText, "%016llx", sourceHash);
+    std::string key = std::string(deviceName) + "\n" + driverVersion + "\n" + deviceVersion + "\n" + buildOptions + "\n" + hashText;
+
+    unsigned long long keyHash = 14695981039346656037ull;
+    for (size_t i = 0; i < key.size(); ++i)
+        keyHash = (keyHash ^ (unsigned char) key[i]) * 1099511628211ull;
+    sprintf(hashText, "%016llx", keyHash);
+    *path = std::string(folder) + "/Kernels." + hashText + ".clbin";
+    return key;
+}
+
+// Returns a built program from the cache, or 0 if there is no usable entry.
+static cl_program LoadCachedProgram(const char* source, const char* buildOptions)
+{
+    std::string path, key = ProgramCacheKey(source, buildOptions, &path);
+    if (key.empty())
+        return 0;
+
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file)
+        return 0;
+
+    unsigned int keyLength = 0;
+    std::string storedKey;
+    std::vector<unsigned char> binary;
+    bool valid = fread(&keyLength, sizeof(keyLength), 1, file) == 1 && keyLength == key.size();
+    if (valid) {
+        storedKey.resize(keyLength);
+        valid = fread(&storedKey[0], 1, keyLength, file) == keyLength && storedKey == key;
+    }
+    if (valid) {
+        unsigned char chunk[4096];
+        size_t read;
+        while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+            binary.insert(binary.end(), chunk, chunk + read);
+        valid = !binary.empty();
+    }
+    fclose(file);
+    if (!valid)
+        return 0;
+
+    const unsigned char* binaries[] = { &binary[0] };
+    size_t size = binary.size();
+    cl_int status = CL_SUCCESS;
+    cl_program cached = clCreateProgramWithBinary(context, 1, &deviceId, &size, binaries, &status, &err);
+    if (cached && (err != CL_SUCCESS || status != CL_SUCCESS || clBuildProgram(cached, 0, NULL, buildOptions, NULL, NULL) != CL_SUCCESS)) {
+        clReleaseProgram(cached);
+        cached = 0;
+    }
+    if (!cached)
+        return 0;
+    PezDebugString("Loaded OpenCL program from %s\n", path.c_str());
+    return cached;
+}
+
+// Failing to write the cache only costs the next run a source build, so it is not an error.
+static void SaveCachedProgram(cl_program built, const char* source, const char* buildOptions)
+{
+    std::string path, key = ProgramCacheKey(source, buildOptions, &path);
+    if (key.empty())
+        return;
+
+    size_t size = 0;
+    clGetProgramInfo(built, CL_PROGRAM_BINARY_SIZES, sizeof(size), &size, NULL);
+    if (!size)
+        return;
+    std::vector<unsigned char> binary(size);
+    unsigned char* binaries[] = { &binary[0] };
+    if (clGetProgramInfo(built, CL_PROGRAM_BINARIES, sizeof(binaries), binaries, NULL) != CL_SUCCESS)
+        return;
+
+    // Written aside and renamed, so that a concurrent run never sees a partial file.
+    std::string partial = path + ".tmp";
+    FILE* file = fopen(partial.c_str(), "wb");
+    if (!file)
+        return;
+    unsigned int keyLength = (unsigned int) key.size();
+    bool written = fwrite(&keyLength, sizeof(keyLength), 1, file) == 1 &&
+                   fwrite(key.c_str(), 1, keyLength, file) == keyLength &&
+                   fwrite(&binary[0], 1, size, file) == size;
+    written = fclose(file) == 0 && written;
+    remove(path.c_str());
+    if (!written || rename(partial.c_str(), path.c_str()) != 0)
+        remove(partial.c_str());
+}
+
+// Creates the context, builds the kernels, and allocates what every volume the size of
+// destination needs.  sharing holds the GL sharing properties, or is null for a plain context.
+static void CreateCompute(const cl_context_properties* sharing, SurfacePod& destination)
+{
+    cl_platform_id platformId;
+    const char* kernelSource;
+    char version_string[128] = {0}, extensions[2048] = {0}, deviceName[256] = {0};
+    int maxSize;
+
+    VolumeSurface = &destination;
+    deviceId = SelectDevice(CL_DEVICE_TYPE_GPU, &platformId);
+
+    clGetDeviceInfo(deviceId, CL_DEVICE_NAME, sizeof(deviceName), &deviceName[0], NULL);
+    clGetDeviceInfo(deviceId, CL_DEVICE_VERSION, sizeof(version_string), &version_string[0], NULL);
+    clGetDeviceInfo(deviceId, CL_DEVICE_EXTENSIONS, sizeof(extensions), &extensions[0], NULL);
+    clGetDeviceInfo(deviceId, CL_DEVICE_MAX_WORK_GROUP_SIZE, sizeof(maxSize), &maxSize, NULL);
+    PezDebugString("%s\n%s\n%d max work items\n%s\n", deviceName, version_string, maxSize, extensions);
+
+    // With cl_khr_gl_event, acquiring and releasing shared objects synchronizes with the GL
+    // context on this thread by itself; without it, pending GL commands must be waited for.
+    implicitSync = strstr(extensions, "cl_khr_gl_event") != 0;
+
+    std::vector<cl_context_properties> props;
+    props.push_back(CL_CONTEXT_PLATFORM);
+    props.push_back((cl_context_properties) platformId);
+    for (; sharing && *sharing; ++sharing)
+        props.push_back(*sharing);
+    props.push_back(0);
+
+    context = clCreateContext(&props[0], 1, &deviceId, handle_error, NULL, 0);
+
+    PezCheckCondition(context != 0, "Failed to create OpenCL context.\n");
+    
+#ifdef PLANE_SPANS
+    const char* buildOptions = "-cl-fast-relaxed-math -D PLANE_SPANS";
+#else
+    const char* buildOptions = "-cl-fast-relaxed-math";
+#endif
+    kernelSource = glswGetShader("Kernels.Surfaces");
+    program = LoadCachedProgram(kernelSource, buildOptions);
+    if (!program) {
+        program = clCreateProgramWithSource(context, 1, &kernelSource, NULL, NULL);
+        err = clBuildProgram(program, 0, NULL, buildOptions, NULL, NULL);
+        if (err != CL_SUCCESS) {
+            size_t len;
+            char buffer[2048] = {0};
+            memset(buffer, 0, sizeof(buffer));
+            clGetProgramBuildInfo(program, deviceId, CL_PROGRAM_BUILD_LOG, sizeof(buffer), buffer, &len);
+            PezFatalError("Error: Failed to build OpenCL kernel\n%s\n", buffer);
+        }
+        SaveCachedProgram(program, kernelSource, buildOptions);
+    }
+
+#ifdef THIN_SURFACE
+    voxelizeKernel = clCreateKernel(program, "voxelize_thin", NULL);
+#else
+    voxelizeKernel = clCreateKernel(program, "voxelize", NULL);
+#endif
+    clearKernel = clCreateKernel(program, "clear_bricks", NULL);
+    markKernel = clCreateKernel(program, "mark_bricks", NULL);
+    PezCheckCondition(clearKernel && markKernel, "Unable to create dirty brick kernels.\n");
+    seedKernel = clCreateKernel(program, "jfa_seed", NULL);
+    jumpKernel = clCreateKernel(program, "jfa_step", NULL);
+    distanceKernel = clCreateKernel(program, "jfa_distance", NULL);
+    PezCheckCondition(seedKernel && jumpKernel && distanceKernel, "Unable to create jump flood kernels.\n");
+    commandQueue = clCreateCommandQueue(context, deviceId, CL_QUEUE_PROFILING_ENABLE, NULL);
+
+#ifdef BRICK_JOBS
+    countKernel = clCreateKernel(program, "count_bricks", NULL);
+    scanKernel = clCreateKernel(program, "scan_bricks", NULL);
+    bricksKernel = clCreateKernel(program, "voxelize_bricks", NULL);
+    PezCheckCondition(countKernel && scanKernel && bricksKernel, "Unable to create brick kernels.\n");
+
+    // Enough work-items to keep every compute unit busy; the kernel loops over the rest.
+    cl_uint computeUnits = 1;
+    clGetDeviceInfo(deviceId, CL_DEVICE_MAX_COMPUTE_UNITS, sizeof(computeUnits), &computeUnits, NULL);
+    bricksGlobalSize = computeUnits * 8 * (size_t) maxSize;
+#endif
+
+    void* empty = calloc(destination.ByteCount, 1);
+    destination.ClearBuffer = clCreateBuffer(context, CL_MEM_COPY_HOST_PTR, destination.ByteCount, empty, &err);
+    free(empty);
+    PezCheckCondition(!err, "Failed to create clear buffer.\n");
+
+    const int b = 8; // BRICK_SIZE in Kernels.cl
+    brickCount = (size_t) ((destination.Width + b - 1) / b) * ((destination.Height + b - 1) / b) * ((destination.Depth + b - 1) / b);
+}
+
+static DirtyBricks CreateDirtyBricks()
+{
+    DirtyBricks dirty;
+    std::vector<cl_uint> zero(brickCount, 0);
+    dirty.Stamps = clCreateBuffer(context, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, brickCount * sizeof(cl_uint), &zero[0], &err);
+    dirty.Epoch = 0;
+    PezCheckCondition(!err, "Failed to create brick stamps.\n");
+    return dirty;
+}
+
+static int AddMesh(cl_mem positions, const cl_uint* indices, unsigned int triangleCount, unsigned int vertexCount)
+{
+    ArenaMesh entry;
+    entry.Positions = positions;
+    entry.Indices.assign(indices, indices + triangleCount * 3);
+    entry.VertexCount = vertexCount;
+    entry.FirstVertex = 0;
+    entry.Live = true;
+    arenaStale = true;
+
+    for (size_t id = 0; id < meshes.size(); ++id)
+        if (!meshes[id].Live) {
+            meshes[id] = entry;
+            return (int) id;
+        }
+    meshes.push_back(entry);
+    return (int) meshes.size() - 1;
+}
+
+void RemoveOpenCL(int id)
+{
+    PezCheckCondition(id >= 0 && id < (int) meshes.size() && meshes[id].Live, "Invalid OpenCL mesh id %d.\n", id);
+    clReleaseMemObject(meshes[id].Positions);
+    std::vector<cl_uint>().swap(meshes[id].Indices);
+    meshes[id].Live = false;
+    arenaStale = true;
+}
+
+// Assigns every live mesh its range of the arena, rebases the indices, and grows the arena
+// and brick job buffers by doubling when they run out of room.
+static void PackArena()
+{
+    arenaVertexCount = arenaTriangleCount = 0;
+    arenaIndices.clear();
+    sharedBuffers.assign(1, (cl_mem) 0);
+    for (size_t id = 0; id < meshes.size(); ++id) {
+        ArenaMesh& mesh = meshes[id];
+        if (!mesh.Live)
+            continue;
+        mesh.FirstVertex = arenaVertexCount;
+        for (size_t i = 0; i < mesh.Indices.size(); ++i)
+            arenaIndices.push_back(mesh.Indices[i] + mesh.FirstVertex);
+        arenaVertexCount += mesh.VertexCount;
+        arenaTriangleCount += (unsigned int) mesh.Indices.size() / 3;
+        sharedBuffers.push_back(mesh.Positions);
+    }
+
+    if (arenaVertexCount > vertexCapacity) {
+        if (vertexCapacity)
+            clReleaseMemObject(arenaPositions);
+        vertexCapacity = vertexCapacity ? vertexCapacity : 1024;
+        while (vertexCapacity < arenaVertexCount)
+            vertexCapacity *= 2;
+        arenaPositions = clCreateBuffer(context, CL_MEM_READ_ONLY, vertexCapacity * 3 * sizeof(float), NULL, &err);
+        PezCheckCondition(err == 0, "Unable to create OpenCL vertex arena");
+    }
+
+    if (arenaTriangleCount > triangleCapacity) {
+        if (triangleCapacity) {
+            clReleaseMemObject(arenaFaces);
+#ifdef BRICK_JOBS
+            clReleaseMemObject(brickCounts);
+            clReleaseMemObject(brickOffsets);
+#endif
+        }
+        triangleCapacity = triangleCapacity ? triangleCapacity : 1024;
+        while (triangleCapacity < arenaTriangleCount)
+            triangleCapacity *= 2;
+        arenaFaces = clCreateBuffer(context, CL_MEM_READ_ONLY, triangleCapacity * 3 * sizeof(cl_uint), NULL, &err);
+        PezCheckCondition(err == 0, "Unable to create OpenCL index arena");
+#ifdef BRICK_JOBS
+        brickCounts = clCreateBuffer(context, CL_MEM_READ_WRITE, triangleCapacity * sizeof(cl_uint), NULL, &err);
+        PezCheckCondition(err == 0, "Unable to create OpenCL brick count buffer");
+        brickOffsets = clCreateBuffer(context, CL_MEM_READ_WRITE, (triangleCapacity + 1) * sizeof(cl_uint), NULL, &err);
+        PezCheckCondition(err == 0, "Unable to create OpenCL brick offset buffer");
+#endif
+    }
+
+    if (arenaTriangleCount) {
+        err = clEnqueueWriteBuffer(commandQueue, arenaFaces, CL_TRUE, 0, arenaIndices.size() * sizeof(cl_uint), &arenaIndices[0], 0, 0, 0);
+        PezCheckCondition(err == 0, "Unable to upload the OpenCL index arena");
+    }
+    arenaStale = false;
+}
+
+// Returns the event slot for the next command of the given step, or null when not profiling.
+// The slot is only valid until the next call.
+static cl_event* ProfileEvent(ProfileStep step)
+{
+    if (!profiling)
+        return 0;
+    PendingEvent pending = { step, 0 };
+    pendingEvents.push_back(pending);
+    return &pendingEvents.back().Event;
+}
+
+// Profiles a command whose event the caller keeps for itself.
+static void ProfileRetain(ProfileStep step, cl_event event)
+{
+    if (!profiling || !event)
+        return;
+    clRetainEvent(event);
+    PendingEvent pending = { step, event };
+    pendingEvents.push_back(pending);
+}
+
+static void HarvestProfile()
+{
+    if (profile.empty()) {
+        profile.resize(StepCountOf);
+        for (int step = 0; step < StepCountOf; ++step) {
+            memset(&profile[step], 0, sizeof(ProfilePod));
+            profile[step].Name = profileNames[step];
+        }
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < pendingEvents.size(); ++i) {
+        PendingEvent pending = pendingEvents[i];
+        if (!pending.Event)
+            continue;
+        cl_int status = CL_COMPLETE;
+        clGetEventInfo(pending.Event, CL_EVENT_COMMAND_EXECUTION_STATUS, sizeof(status), &status, 0);
+        if (status > CL_COMPLETE) {
+            pendingEvents[kept++] = pending;
+            continue;
+        }
+
+        // A negative status is a failed command, which has no meaningful times.
+        if (status == CL_COMPLETE) {
+            cl_ulong queued = 0, submitted = 0, start = 0, end = 0;
+            clGetEventProfilingInfo(pending.Event, CL_PROFILING_COMMAND_QUEUED, sizeof(queued), &queued, 0);
+            clGetEventProfilingInfo(pending.Event, CL_PROFILING_COMMAND_SUBMIT, sizeof(submitted), &submitted, 0);
+            clGetEventProfilingInfo(pending.Event, CL_PROFILING_COMMAND_START, sizeof(start), &start, 0);
+            clGetEventProfilingInfo(pending.Event, CL_PROFILING_COMMAND_END, sizeof(end), &end, 0);
+
+            ProfilePod& stats = profile[pending.Step];
+            double run = (end - start) / 1000.0;
+            stats.QueuedMicroseconds += (submitted - queued) / 1000.0;
+            stats.SubmittedMicroseconds += (start - submitted) / 1000.0;
+            stats.RunMicroseconds += run;
+            stats.MinRunMicroseconds = stats.Count ? std::min(stats.MinRunMicroseconds, run) : run;
+            stats.MaxRunMicroseconds = std::max(stats.MaxRunMicroseconds, run);
+            stats.Count++;
+        }
+        clReleaseEvent(pending.Event);
+    }
+    pendingEvents.resize(kept);
+}
+
+void EnableOpenCLProfiling(bool enable)
+{
+    profiling = enable;
+}
+
+// Totals for the commands that have completed so far, one entry per step.
+const std::vector<ProfilePod>& GetOpenCLProfile()
+{
+    HarvestProfile();
+    return profile;
+}
+
+void ResetOpenCLProfile()
+{
+    HarvestProfile();
+    profile.clear();
+}
+
+void DumpOpenCLProfile()
+{
+    const std::vector<ProfilePod>& stats = GetOpenCLProfile();
+    PezDebugString("%-14s %7s %12s %12s %12s %12s %12s\n", "step", "count", "queued", "submitted", "run", "min run", "max run");
+    for (size_t i = 0; i < stats.size(); ++i) {
+        const ProfilePod& step = stats[i];
+        if (!step.Count)
+            continue;
+        PezDebugString("%-14s %7u %12.1f %12.1f %12.1f %12.1f %12.1f\n", step.Name, step.Count,
+            step.QueuedMicroseconds / step.Count, step.SubmittedMicroseconds / step.Count,
+            step.RunMicroseconds / step.Count, step.MinRunMicroseconds, step.MaxRunMicroseconds);
+    }
+}
+
+// Enqueues the clear of volumeBuffer and the voxelization of every registered mesh into it.
+// The arena must be packed, and on the interop path the shared buffers acquired.
+static void EnqueueVoxelize(cl_mem volumeBuffer, DirtyBricks& dirty, Point3 minCorner, Point3 maxCorner, cl_event* started)
+{
+    size_t localSize;
+    clGetKernelWorkGroupInfo(voxelizeKernel, deviceId, CL_KERNEL_WORK_GROUP_SIZE, sizeof(int), &localSize, 0) ;
+
+    err = 0;
+    for (size_t id = 0; id < meshes.size(); ++id)
+        if (meshes[id].Live)
+            err |= clEnqueueCopyBuffer(commandQueue, meshes[id].Positions, arenaPositions, 0,
+                meshes[id].FirstVertex * 3 * sizeof(float), meshes[id].VertexCount * 3 * sizeof(float), 0, 0, ProfileEvent(StepGather));
+    PezCheckCondition(err == 0, "Unable to gather mesh positions into the OpenCL arena\n");
+
+    float xscale = VolumeSurface->Width / (maxCorner[0] - minCorner[0]);
+    float yscale = VolumeSurface->Height / (maxCorner[1] - minCorner[1]);
+    float zscale = VolumeSurface->Depth / (maxCorner[2] - minCorner[2]);
+    float xoffset = -minCorner[0];
+    float yoffset = -minCorner[1];
+    float zoffset = -minCorner[2];
+
+    // The first pass over a buffer clears all of it; later ones only clear the bricks the
+    // previous pass stamped, so the cost follows the surface rather than the grid.
+    if (!dirty.Epoch) {
+        err |= clEnqueueCopyBuffer(commandQueue, (cl_mem) VolumeSurface->ClearBuffer, volumeBuffer, 0, 0, VolumeSurface->ByteCount, 0, 0, started);
+    } else {
+        size_t clearWorkSize[] = { snap(brickCount * 8 * 8, localSize) };
+        size_t clearLocalSize[] = { localSize };
+        err |= clSetKernelArg(clearKernel, 0, sizeof(cl_mem), &volumeBuffer);
+        err |= clSetKernelArg(clearKernel, 1, sizeof(cl_mem), &dirty.Stamps);
+        err |= clSetKernelArg(clearKernel, 2, sizeof(cl_uint), &dirty.Epoch);
+        err |= clSetKernelArg(clearKernel, 3, sizeof(int), &VolumeSurface->RowPitch);
+        err |= clSetKernelArg(clearKernel, 4, sizeof(int), &VolumeSurface->SlicePitch);
+        err |= clSetKernelArg(clearKernel, 5, sizeof(int), &VolumeSurface->Width);
+        err |= clSetKernelArg(clearKernel, 6, sizeof(int), &VolumeSurface->Height);
+        err |= clSetKernelArg(clearKernel, 7, sizeof(int), &VolumeSurface->Depth);
+        err |= clEnqueueNDRangeKernel(commandQueue, clearKernel, 1, NULL, clearWorkSize, clearLocalSize, 0, NULL, started);
+    }
+    ProfileRetain(StepClear, *started);
+    PezCheckCondition(!err, "Unable to enqueue volume clear: error code is %d\n", err);
+    if (++dirty.Epoch == 0)
+        ++dirty.Epoch;
+
+    err |= clSetKernelArg(voxelizeKernel, 0, sizeof(cl_mem), &volumeBuffer);
+    err |= clSetKernelArg(markKernel, 0, sizeof(cl_mem), &dirty.Stamps);
+    err |= clSetKernelArg(markKernel, 15, sizeof(cl_uint), &dirty.Epoch);
+
+#ifdef BRICK_JOBS
+    // The brick kernels share the voxelize argument layout, except that count_bricks writes to
+    // brickCounts and mark_bricks to the stamps.
+    cl_kernel kernels[] = { voxelizeKernel, markKernel, bricksKernel, countKernel };
+    err |= clSetKernelArg(bricksKernel, 0, sizeof(cl_mem), &volumeBuffer);
+    err |= clSetKernelArg(countKernel, 0, sizeof(cl_mem), &brickCounts);
+#else
+    cl_kernel kernels[] = { voxelizeKernel, markKernel };
+#endif
+
+    for (unsigned int k = 0; k < sizeof(kernels) / sizeof(kernels[0]); ++k)
+    {
+        err |= clSetKernelArg(kernels[k], 1, sizeof(float), &xscale);
+        err |= clSetKernelArg(kernels[k], 2, sizeof(float), &yscale);
+        err |= clSetKernelArg(kernels[k], 3, sizeof(float), &zscale);
+        err |= clSetKernelArg(kernels[k], 4, sizeof(float), &xoffset);
+        err |= clSetKernelArg(kernels[k], 5, sizeof(float), &yoffset);
+        err |= clSetKernelArg(kernels[k], 6, sizeof(float), &zoffset);
+        err |= clSetKernelArg(kernels[k], 7, sizeof(int), &VolumeSurface->RowPitch);
+        err |= clSetKernelArg(kernels[k], 8, sizeof(int), &VolumeSurface->SlicePitch);
+        err |= clSetKernelArg(kernels[k], 9, sizeof(int), &VolumeSurface->Width);
+        err |= clSetKernelArg(kernels[k], 10, sizeof(int), &VolumeSurface->Height);
+        err |= clSetKernelArg(kernels[k], 11, sizeof(int), &VolumeSurface->Depth);
+    }
+    PezCheckCondition(!err, "Unable to set arguments 0-11 on OpenCL kernel");
+
+    size_t localWorkSize[] = { localSize };
+
+    for (unsigned int k = 0; k < sizeof(kernels) / sizeof(kernels[0]); ++k) {
+        err |= clSetKernelArg(kernels[k], 12, sizeof(cl_mem), (void*) &arenaPositions);
+        err |= clSetKernelArg(kernels[k], 13, sizeof(cl_mem), (void*) &arenaFaces);
+        err |= clSetKernelArg(kernels[k], 14, sizeof(int), (void*) &arenaTriangleCount);
+    }
+    PezCheckCondition(err == 0, "Unable to set arguments 12-14 on OpenCL kernels");
+
+    // Every mesh goes in the same launches.
+    if (arenaTriangleCount)
+    {
+        size_t markWorkSize[] = { snap(arenaTriangleCount, localWorkSize[0]) };
+        err = clEnqueueNDRangeKernel(commandQueue, markKernel, 1, NULL, markWorkSize, localWorkSize, 0, NULL, ProfileEvent(StepMark));
+        PezCheckCondition(err == 0, "Unable to enqueue 'mark_bricks' kernel: error code is %d\n", err);
+
+#ifdef BRICK_JOBS
+        // Phase one: count the bricks covering each triangle's AABB and prefix-sum them.
+        err |= clSetKernelArg(bricksKernel, 15, sizeof(cl_mem), &brickOffsets);
+        err |= clSetKernelArg(scanKernel, 0, sizeof(cl_mem), &brickCounts);
+        err |= clSetKernelArg(scanKernel, 1, sizeof(cl_mem), &brickOffsets);
+        err |= clSetKernelArg(scanKernel, 2, sizeof(int), (void*) &arenaTriangleCount);
+        err |= clSetKernelArg(scanKernel, 3, localSize * sizeof(cl_uint), NULL);
+        PezCheckCondition(err == 0, "Unable to set arguments on OpenCL brick kernels");
+
+        size_t countWorkSize[] = { snap(arenaTriangleCount, localWorkSize[0]) };
+        err = clEnqueueNDRangeKernel(commandQueue, countKernel, 1, NULL, countWorkSize, localWorkSize, 0, NULL, ProfileEvent(StepCount));
+        err |= clEnqueueNDRangeKernel(commandQueue, scanKernel, 1, NULL, localWorkSize, localWorkSize, 0, NULL, ProfileEvent(StepScan));
+
+        // Phase two: one (triangle, brick) job per work-item.
+        size_t bricksWorkSize[] = { snap(bricksGlobalSize, localWorkSize[0]) };
+        err |= clEnqueueNDRangeKernel(commandQueue, bricksKernel, 1, NULL, bricksWorkSize, localWorkSize, 0, NULL, ProfileEvent(StepVoxelize));
+        PezCheckCondition(err == 0, "Unable to enqueue OpenCL brick kernels: error code is %d=%8.8x\n", err, err);
+#else
+        size_t globalWorkSize[] = { snap(arenaTriangleCount, localWorkSize[0]) };
+
+        err = clEnqueueNDRangeKernel(commandQueue, voxelizeKernel, 1, NULL, globalWorkSize, localWorkSize, 0, NULL, ProfileEvent(StepVoxelize));
+        PezCheckCondition(err != CL_INVALID_KERNEL_ARGS, "Unable to enqueue 'Voxelize' kernel: invalid kernel args\n");
+        PezCheckCondition(err == 0, "Unable to enqueue OpenCL kernel: error code is %d=%8.8x\n", err, err);
+#endif
+    }
+}
+
+// Enqueues the jump flood of volumeBuffer into distanceBuffer, allocating the buffers the
+// first time.  Seeds pack each coordinate into 10 bits, hence the limit on the grid.
+static void EnqueueJumpFlood(cl_mem volumeBuffer)
+{
+    const int width = VolumeSurface->Width, height = VolumeSurface->Height, depth = VolumeSurface->Depth;
+    const size_t voxelCount = (size_t) width * height * depth;
+    if (!distanceBuffer) {
+        PezCheckCondition(width <= 1024 && height <= 1024 && depth <= 1024, "Jump flooding needs a grid of at most 1024^3.\n");
+        for (int i = 0; i < 2; ++i) {
+            seedBuffers[i] = clCreateBuffer(context, CL_MEM_READ_WRITE, voxelCount * sizeof(cl_uint), NULL, &err);
+            PezCheckCondition(!err, "Failed to create jump flood seeds.\n");
+        }
+        distanceBuffer = clCreateBuffer(context, CL_MEM_READ_WRITE, VolumeSurface->ByteCount * sizeof(float), NULL, &err);
+        PezCheckCondition(!err, "Failed to create the distance volume.\n");
+    }
+
+    size_t localSize;
+    clGetKernelWorkGroupInfo(jumpKernel, deviceId, CL_KERNEL_WORK_GROUP_SIZE, sizeof(size_t), &localSize, 0);
+    size_t localWorkSize[] = { localSize };
+    size_t globalWorkSize[] = { snap(voxelCount, localSize) };
+
+    err = 0;
+    err |= clSetKernelArg(seedKernel, 0, sizeof(cl_mem), &volumeBuffer);
+    err |= clSetKernelArg(seedKernel, 1, sizeof(cl_mem), &seedBuffers[0]);
+    err |= clSetKernelArg(distanceKernel, 1, sizeof(cl_mem), &distanceBuffer);
+    cl_kernel pitched[] = { seedKernel, distanceKernel };
+    for (int k = 0; k < 2; ++k) {
+        err |= clSetKernelArg(pitched[k], 2, sizeof(int), &VolumeSurface->RowPitch);
+        err |= clSetKernelArg(pitched[k], 3, sizeof(int), &VolumeSurface->SlicePitch);
+        err |= clSetKernelArg(pitched[k], 4, sizeof(int), &width);
+        err |= clSetKernelArg(pitched[k], 5, sizeof(int), &height);
+        err |= clSetKernelArg(pitched[k], 6, sizeof(int), &depth);
+    }
+    err |= clSetKernelArg(jumpKernel, 3, sizeof(int), &width);
+    err |= clSetKernelArg(jumpKernel, 4, sizeof(int), &height);
+    err |= clSetKernelArg(jumpKernel, 5, sizeof(int), &depth);
+    PezCheckCondition(!err, "Unable to set arguments on the jump flood kernels");
+    err = clEnqueueNDRangeKernel(commandQueue, seedKernel, 1, NULL, globalWorkSize, localWorkSize, 0, NULL, ProfileEvent(StepJumpFlood));
+
+    // Steps from half the grid, rounded up to a power of two, down to 1, then 1 once more.
+    int extent = std::max(width, std::max(height, depth));
+    int first = 1;
+    while (first * 2 < extent)
+        first *= 2;
+    int current = 0;
+    for (int step = first; ; step /= 2) {
+        err |= clSetKernelArg(jumpKernel, 0, sizeof(cl_mem), &seedBuffers[current]);
+        err |= clSetKernelArg(jumpKernel, 1, sizeof(cl_mem), &seedBuffers[1 - current]);
+        err |= clSetKernelArg(jumpKernel, 2, sizeof(int), &step);
+        err |= clEnqueueNDRangeKernel(commandQueue, jumpKernel, 1, NULL, globalWorkSize, localWorkSize, 0, NULL, ProfileEvent(StepJumpFlood));
+        current = 1 - current;
+        if (step == 1)
+            break;
+    }
+    err |= clSetKernelArg(jumpKernel, 0, sizeof(cl_mem), &seedBuffers[current]);
+    err |= clSetKernelArg(jumpKernel, 1, sizeof(cl_mem), &seedBuffers[1 - current]);
+    err |= clEnqueueNDRangeKernel(commandQueue, jumpKernel, 1, NULL, globalWorkSize, localWorkSize, 0, NULL, ProfileEvent(StepJumpFlood));
+    current = 1 - current;
+
+    err |= clSetKernelArg(distanceKernel, 0, sizeof(cl_mem), &seedBuffers[current]);
+    err |= clEnqueueNDRangeKernel(commandQueue, distanceKernel, 1, NULL, globalWorkSize, localWorkSize, 0, NULL, ProfileEvent(StepJumpFlood));
+    PezCheckCondition(!err, "Unable to enqueue the jump flood: error code is %d\n", err);
+}
+
+void EnableOpenCLDistances(bool enable)
+{
+    distances = enable;
+}
+
+// Time from the start of the first command to the end of the last, on a profiling queue.
+static double ElapsedMicroseconds(cl_event first, cl_event last)
+{
+    cl_ulong start = 0, end = 0;
+    clGetEventProfilingInfo(first, CL_PROFILING_COMMAND_START, sizeof(start), &start, 0);
+    clGetEventProfilingInfo(last, CL_PROFILING_COMMAND_END, sizeof(end), &end, 0);
+    return (end - start) / 1000.0;
+}
+
+#ifndef HEADLESS
+
+void InitOpenCL(SurfacePod& destination, SurfacePod& backDestination)
+{
+    cl_context_properties glContext, hdc;
+    PezGetContext((int**) &glContext, (int**) &hdc);
+
+    cl_context_properties sharing[] = {
+        CL_GL_CONTEXT_KHR, glContext,
+        CL_WGL_HDC_KHR, hdc,
+        0
+    };
+    CreateCompute(sharing, destination);
+
+    volumeSlots[0].Surface = &destination;
+    volumeSlots[1].Surface = &backDestination;
+    for (int slot = 0; slot < 2; ++slot)
+    {
+        err = 0;
+        // Read as well as written, by the jump flood.
+        volumeSlots[slot].Pbo = clCreateFromGLBuffer(context, CL_MEM_READ_WRITE, volumeSlots[slot].Surface->Pbo, &err);
+        volumeSlots[slot].Started = 0;
+        volumeSlots[slot].Done = 0;
+        volumeSlots[slot].Unpacked = true;
+        switch (err)
+        {
+            case CL_INVALID_CONTEXT:   PezFatalError("OpenCL invalid context."); break;
+            case CL_INVALID_VALUE:     PezFatalError("OpenCL invalid value."); break;
+            case CL_INVALID_MIP_LEVEL: PezFatalError("OpenCL invalid mip level."); break;
+            case CL_INVALID_GL_OBJECT: PezFatalError("OpenCL invalid GL object."); break;
+            case CL_INVALID_IMAGE_FORMAT_DESCRIPTOR: PezFatalError("OpenCL image format desc."); break;
+            case CL_INVALID_OPERATION:  PezFatalError("OpenCL invalid operation."); break;
+            case CL_OUT_OF_RESOURCES:   PezFatalError("OpenCL out of resources."); break;
+            case CL_OUT_OF_HOST_MEMORY: PezFatalError("OpenCL out of host memory."); break;
+            case CL_SUCCESS: break;
+            default: PezFatalError("OpenCL error.");
+        }
+    }
+
+    destination.ComputeBuffer = clCreateBuffer(context, CL_MEM_WRITE_ONLY, destination.ByteCount, NULL, &err);
+    PezCheckCondition(!err, "Failed to create staging buffer for 3D writes.\n");
+
+    volumeSlots[0].Bricks = CreateDirtyBricks();
+    volumeSlots[1].Bricks = CreateDirtyBricks();
+    stagingBricks = CreateDirtyBricks();
+}
+
+int AddOpenCL(const MeshPod& mesh)
+{
+    cl_mem positions = clCreateFromGLBuffer(context, CL_MEM_READ_ONLY, mesh.PositionsBuffer, &err);
+    PezCheckCondition(err == 0, "Unable to create OpenCL point buffer");
+
+    // Indices stay put while the tubes animate, so a host copy is taken once.
+    std::vector<cl_uint> indices(mesh.TriangleCount * 3);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.TriangleBuffer);
+    glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indices.size() * sizeof(cl_uint), &indices[0]);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    PezCheckCondition(glGetError() == GL_NO_ERROR, "Unable to read back mesh indices.\n");
+
+    return AddMesh(positions, &indices[0], mesh.TriangleCount, mesh.VertexCount);
+}
+
+SurfacePod& RunOpenCL(Point3 minCorner, Point3 maxCorner, double* microseconds)
+{
+    VolumeSlot& target = volumeSlots[writeSlot];
+    if (target.Done) {
+        clReleaseEvent(target.Started);
+        clReleaseEvent(target.Done);
+    }
+
+    // A fence only waits for the GL commands issued so far, unlike a full glFinish.
+    if (!implicitSync) {
+        GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        glDeleteSync(fence);
+    }
+
+    if (arenaStale)
+        PackArena();
+
+    sharedBuffers[0] = target.Pbo;
+    err = clEnqueueAcquireGLObjects(commandQueue, (cl_uint) sharedBuffers.size(), &sharedBuffers[0], 0,0, ProfileEvent(StepAcquire));
+    PezCheckCondition(err == 0, "Unable to lock vertex buffers for OpenCL\n");
+
+#ifdef DIRECT_TEXTURE_WRITES
+    EnqueueVoxelize(target.Pbo, target.Bricks, minCorner, maxCorner, &target.Started);
+#else
+    EnqueueVoxelize((cl_mem) VolumeSurface->ComputeBuffer, stagingBricks, minCorner, maxCorner, &target.Started);
+    err = clEnqueueCopyBuffer(commandQueue, (cl_mem) VolumeSurface->ComputeBuffer, target.Pbo, 0, 0, VolumeSurface->ByteCount, 0, 0, ProfileEvent(StepCopy));
+    PezCheckCondition(!err, "Unable to copy buffer: error code is %d\n", err);
+#endif
+    if (distances)
+        EnqueueJumpFlood(target.Pbo);
+
+    err = clEnqueueReleaseGLObjects(commandQueue, (cl_uint) sharedBuffers.size(), &sharedBuffers[0], 0,0, &target.Done);
+    PezCheckCondition(err == 0, "Unable to release buffers back to OpenGL");
+    ProfileRetain(StepRelease, target.Done);
+    clFlush(commandQueue);
+    target.Unpacked = false;
+
+    // Show the volume finished during the previous frame; on the first frame there is none,
+    // so wait for this one.
+    VolumeSlot* ready = &volumeSlots[1 - writeSlot];
+    if (!ready->Done)
+        ready = &target;
+    writeSlot = 1 - writeSlot;
+
+    clWaitForEvents(1, &ready->Done);
+    if (profiling)
+        HarvestProfile();
+    if (ready->Unpacked)
+        return *ready->Surface;
+
+    if (microseconds)
+        *microseconds = ElapsedMicroseconds(ready->Started, ready->Done);
+
+    SurfacePod& surface = *ready->Surface;
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, surface.Pbo);
+    glBindTexture(GL_TEXTURE_3D, surface.ColorTexture);
+    glTexImage3D(GL_TEXTURE_3D, 0, GL_R8, surface.Width, surface.Height, surface.Depth, 0, GL_RED, GL_UNSIGNED_BYTE, 0);
+    glBindTexture(GL_TEXTURE_3D, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    PezCheckCondition(glGetError() == GL_NO_ERROR, "Unable to copy PBO to OpenGL Texture.\n");
+    ready->Unpacked = true;
+    return surface;
+}
+
+#endif
+
+// The headless path: plain buffers in a context without GL sharing, for batch hosts with no
+// display.  Kernels.cl is looked up in kernelFolder, a path prefix such as "../".  Built
+// with HEADLESS defined, this file leaves out the interop path above and needs no GL context,
+// only the Pez debug and error functions.
+void InitHeadlessOpenCL(int width, int height, int depth, const char* kernelFolder)
+{
+    if (glswInit())
+        glswAddPath(kernelFolder, ".cl");
+
+    headlessSurface.Width = width;
+    headlessSurface.Height = height;
+    headlessSurface.Depth = depth;
+    headlessSurface.RowPitch = width;
+    headlessSurface.SlicePitch = width * height;
+    headlessSurface.ByteCount = width * height * depth;
+    CreateCompute(0, headlessSurface);
+
+    headlessSurface.ComputeBuffer = clCreateBuffer(context, CL_MEM_READ_WRITE, headlessSurface.ByteCount, NULL, &err);
+    PezCheckCondition(!err, "Failed to create the headless volume.\n");
+    headlessBricks = CreateDirtyBricks();
+}
+
+int AddHeadlessMesh(const float* positions, unsigned int vertexCount, const unsigned int* indices, unsigned int triangleCount)
+{
+    cl_mem buffer = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, vertexCount * 3 * sizeof(float), (void*) positions, &err);
+    PezCheckCondition(err == 0, "Unable to create OpenCL point buffer");
+    return AddMesh(buffer, indices, triangleCount, vertexCount);
+}
+
+void UpdateHeadlessMesh(int id, const float* positions)
+{
+    PezCheckCondition(id >= 0 && id < (int) meshes.size() && meshes[id].Live, "Invalid OpenCL mesh id %d.\n", id);
+    err = clEnqueueWriteBuffer(commandQueue, meshes[id].Positions, CL_TRUE, 0, meshes[id].VertexCount * 3 * sizeof(float), positions, 0, 0, 0);
+    PezCheckCondition(err == 0, "Unable to update OpenCL point buffer");
+}
+
+// Voxelizes every mesh and, if dest is not null, reads the volume back into it, linear with
+// Z flipped like the textures.  Returns the device time of the voxelization, and of the jump
+// flood if distances are enabled, in microseconds.
+double RunHeadlessOpenCL(Point3 minCorner, Point3 maxCorner, unsigned char* dest)
+{
+    if (arenaStale)
+        PackArena();
+
+    cl_event started, done;
+    cl_mem volume = (cl_mem) headlessSurface.ComputeBuffer;
+    EnqueueVoxelize(volume, headlessBricks, minCorner, maxCorner, &started);
+    if (distances)
+        EnqueueJumpFlood(volume);
+    err = clEnqueueMarker(commandQueue, &done);
+    if (dest)
+        err |= clEnqueueReadBuffer(commandQueue, volume, CL_FALSE, 0, headlessSurface.ByteCount, dest, 0, 0, ProfileEvent(StepRead));
+    PezCheckCondition(err == 0, "Unable to read back the headless volume: error code is %d\n", err);
+    clFinish(commandQueue);
+    if (profiling)
+        HarvestProfile();
+
+    double microseconds = ElapsedMicroseconds(started, done);
+    clReleaseEvent(started);
+    clReleaseEvent(done);
+    return microseconds;
+}
+
+// Reads back the distances of the last headless pass, laid out like its volume.
+void ReadHeadlessDistances(float* dest)
+{
+    PezCheckCondition(distanceBuffer != 0, "No distances; enable them before running OpenCL.\n");
+    err = clEnqueueReadBuffer(commandQueue, distanceBuffer, CL_TRUE, 0, headlessSurface.ByteCount * sizeof(float), dest, 0, 0, ProfileEvent(StepRead));
+    PezCheckCondition(err == 0, "Unable to read back the distances: error code is %d\n", err);
+}
+
+// Releases everything created since InitOpenCL or InitHeadlessOpenCL, so that either can be
+// called again, say for a volume of another size.
+void ClearOpenCL()
+{
+    if (!context)
+        return;
+    clFinish(commandQueue);
+    if (profiling)
+        HarvestProfile();
+
+    for (size_t id = 0; id < meshes.size(); ++id)
+        if (meshes[id].Live)
+            clReleaseMemObject(meshes[id].Positions);
+    meshes.clear();
+    sharedBuffers.clear();
+    arenaIndices.clear();
+    if (vertexCapacity)
+        clReleaseMemObject(arenaPositions);
+    if (triangleCapacity) {
+        clReleaseMemObject(arenaFaces);
+#ifdef BRICK_JOBS
+        clReleaseMemObject(brickCounts);
+        clReleaseMemObject(brickOffsets);
+#endif
+    }
+    vertexCapacity = triangleCapacity = 0;
+    arenaVertexCount = arenaTriangleCount = 0;
+    arenaStale = true;
+
+    DirtyBricks* dirty[] = { &volumeSlots[0].Bricks, &volumeSlots[1].Bricks, &stagingBricks, &headlessBricks };
+    for (int i = 0; i < 4; ++i) {
+        if (dirty[i]->Stamps)
+            clReleaseMemObject(dirty[i]->Stamps);
+        dirty[i]->Stamps = 0;
+    }
+    for (int slot = 0; slot < 2; ++slot) {
+        VolumeSlot& target = volumeSlots[slot];
+        if (target.Pbo)
+            clReleaseMemObject(target.Pbo);
+        if (target.Done) {
+            clReleaseEvent(target.Started);
+            clReleaseEvent(target.Done);
+        }
+        target.Pbo = 0;
+        target.Started = target.Done = 0;
+    }
+    writeSlot = 0;
+
+    clReleaseMemObject((cl_mem) VolumeSurface->ComputeBuffer);
+    clReleaseMemObject((cl_mem) VolumeSurface->ClearBuffer);
+    VolumeSurface->ComputeBuffer = VolumeSurface->ClearBuffer = 0;
+
+    clReleaseKernel(voxelizeKernel);
+    clReleaseKernel(clearKernel);
+    clReleaseKernel(markKernel);
+    clReleaseKernel(seedKernel);
+    clReleaseKernel(jumpKernel);
+    clReleaseKernel(distanceKernel);
+    if (distanceBuffer) {
+        clReleaseMemObject(seedBuffers[0]);
+        clReleaseMemObject(seedBuffers[1]);
+        clReleaseMemObject(distanceBuffer);
+        seedBuffers[0] = seedBuffers[1] = distanceBuffer = 0;
+    }
+#ifdef BRICK_JOBS
+    clReleaseKernel(countKernel);
+    clReleaseKernel(scanKernel);
+    clReleaseKernel(bricksKernel);
+#endif
+    clReleaseProgram(program);
+    clReleaseCommandQueue(commandQueue);
+    clReleaseContext(context);
+    context = 0;
+}
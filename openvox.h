@@ -3,10 +3,19 @@
 #pragma once
 #define VOX_API_VERSION 0x00000100
 
+#if !defined(__gl_h_) && !defined(__GL_H__)
+typedef unsigned int GLuint; // lets headless clients include this header without OpenGL
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 typedef void*          VOXhandle;
 typedef char           VOXbool;
 typedef unsigned short VOXushort;
 typedef unsigned int   VOXuint;
+typedef unsigned long long VOXuint64;
 typedef float          VOXfloat;
 
 typedef enum {
@@ -15,8 +24,12 @@ typedef enum {
     VOX_TRUE  = 0x0001,
     
     // TODO: Popular pixel and voxel types need to be enumerated
-    VOX_TYPE_UINT32 = 0x4000,
-    VOX_TYPE_UINT16 = 0x4001,
+    VOX_TYPE_UINT32  = 0x4000,
+    VOX_TYPE_UINT16  = 0x4001,
+    VOX_TYPE_UINT8   = 0x4002,
+    VOX_TYPE_BIT     = 0x4003, // 1-bit occupancy; rows are packed LSB-first into 64-bit words
+    VOX_TYPE_FLOAT32 = 0x4004, // IEEE single precision, e.g. distances; clear values are taken as raw bits
+    VOX_TYPE_FLOAT32X4 = 0x4005, // four floats, e.g. vectors in xyz; clear values fill every component
     
     VOX_SOURCE_CL_BUFFER   = 0x3001, // sourceData is a handle to an OpenCL memory buffer
     VOX_SOURCE_CL_IMAGE    = 0x3002, // sourceData is a handle to an OpenCL image object
@@ -33,13 +46,16 @@ typedef enum {
     VOX_VOXELIZE_SPATIAL_HASH         = 0x0103,
     VOX_VOXELIZE_SURFACE_OCTREE       = 0x0104,
     VOX_VOXELIZE_SURFACE_THIN         = 0x0105,
-
-    VOX_TRANSFORM_DISTANCE_EUCLIDEAN     = 0x0200,
-    VOX_TRANSFORM_DISTANCE_SQR_EUCLIDEAN = 0x0201,
-    VOX_TRANSFORM_DISTANCE_MANHATTAN     = 0x0202,
-    VOX_TRANSFORM_GRADIENT               = 0x0300,
-    VOX_TRANSFORM_CURL                   = 0x0301,
-    VOX_TRANSFORM_FLUID_ADVECT           = 0x0400,
+    VOX_VOXELIZE_SURFACE_REFERENCE    = 0x0106, // exact closed-box overlap in double precision; slow, for checking the others
+
+    VOX_TRANSFORM_DISTANCE_EUCLIDEAN     = 0x0200, // voxels to the nearest non-zero source voxel, into a dense
+    VOX_TRANSFORM_DISTANCE_SQR_EUCLIDEAN = 0x0201, // volume; integer types round and saturate, and float
+    VOX_TRANSFORM_DISTANCE_MANHATTAN     = 0x0202, // ones are infinite where the source is all zero
+    VOX_TRANSFORM_DISTANCE_NARROW_BAND   = 0x0203, // signed, negative inside, within VOX_PARAM_NARROW_BAND; float volumes
+    VOX_TRANSFORM_GRADIENT               = 0x0300, // central differences of a scalar volume into FLOAT32X4 (xyz, length
+    VOX_TRANSFORM_CURL                   = 0x0301, // in w), or just the length into FLOAT32; curls take FLOAT32X4 xyz
+    VOX_TRANSFORM_GRADIENT_NORMALS       = 0x0302, // unit vectors against the gradient, and its length in w; FLOAT32X4
+    VOX_TRANSFORM_FLUID_ADVECT           = 0x0400, // semi-Lagrangian step of a FLOAT32 or FLOAT32X4 volume along VOX_PARAM_FLUID_VELOCITY
     VOX_TRANSFORM_FLUID_JACOBI           = 0x0401,
 
     VOX_BLEND_ADD      = 0x1000,
@@ -51,13 +67,33 @@ typedef enum {
     VOX_GENERATE_NOISE = 0x2001,
     VOX_GENERATE_SPLAT = 0x2002,
 
+    VOX_STORAGE_DENSE  = 0x5000, // one linear allocation
+    VOX_STORAGE_SPARSE = 0x5001, // 8x8x8 bricks allocated on first write
+    VOX_STORAGE_HASH   = 0x5002, // coordinates of the set voxels only, up to 2^21 voxels per axis
+    VOX_STORAGE_OCTREE = 0x5003, // sparse voxel octree, up to 2^21 voxels per axis; written by VOX_VOXELIZE_SURFACE_OCTREE only
+
+    VOX_LAYOUT_LINEAR = 0x6000, // x-fastest rows, then rows, then slices
+    VOX_LAYOUT_TILED  = 0x6001, // 8x8x8 tiles in Z-order inside, tiles in linear order; dense volumes only
+
     VOX_PARAM_CLEAR_VALUE      = 0x80000000,
     VOX_PARAM_SCISSOR_ENABLE   = 0x80000001,
     VOX_PARAM_SCISSOR_REGION   = 0x80000002,
     VOX_PARAM_NOISE_OCTAVE     = 0x80000003,
     VOX_PARAM_NOISE_COEFF      = 0x80000004,
     VOX_PARAM_SPLAT_COEFF      = 0x80000005,
-    VOX_PARAM_FLUID_OBSTACLES  = 0x80000006,
+    VOX_PARAM_FLUID_OBSTACLES  = 0x80000006, // handle: volume that is non-zero where fluid cannot go (0 = none)
+    VOX_PARAM_VOXELIZE_BOUNDS  = 0x80000007, // 6 floats: min corner, max corner (defaults to the mesh bounds, read back as zeros)
+    VOX_PARAM_THREAD_COUNT     = 0x80000008, // worker threads for contexts created afterwards (0 = all cores)
+    VOX_PARAM_SIMD_WIDTH       = 0x80000009, // voxels per overlap-test instruction for new contexts: 1, 8, 16 (0 = widest)
+    VOX_PARAM_PLANE_SPANS      = 0x8000000A, // bool: only test voxels within each row's slab of the triangle's plane
+    VOX_PARAM_VOLUME_STORAGE   = 0x8000000B, // VOX_STORAGE_* for volumes created afterwards
+    VOX_PARAM_INCREMENTAL      = 0x8000000C, // bool: voxVoxelize only redoes the bricks touched by meshes that moved
+    VOX_PARAM_VOLUME_LAYOUT    = 0x8000000D, // VOX_LAYOUT_* for dense volumes created afterwards
+    VOX_PARAM_REFERENCE_MARGIN = 0x8000000E, // float: voxels added to each side of VOX_VOXELIZE_SURFACE_REFERENCE's boxes
+    VOX_PARAM_NARROW_BAND      = 0x8000000F, // float: voxels from the surface that signed distances reach (default 3)
+    VOX_PARAM_SIGN_VOLUME      = 0x80000010, // handle: volume that is non-zero inside (0 = flood fill from the border)
+    VOX_PARAM_FLUID_VELOCITY   = 0x80000011, // handle: FLOAT32X4 velocities in voxels per step (0 = the source itself)
+    VOX_PARAM_FLUID_TIME_STEP  = 0x80000012, // float: steps per advection; non-zero (default 1)
 
 } VOXenum;
 
@@ -81,6 +117,22 @@ VOXhandle voxRegisterMeshIndexed(
     VOXenum indexType,
     VOXuint triangleCount);
 
+// Registers a mesh that lives in CPU memory; no OpenGL context is required.
+// indexData may be null, in which case every three vertices form a triangle.
+VOXhandle voxRegisterMeshPtr(
+    VOXhandle context,
+    const void* vertexData,
+    const void* indexData,
+    VOXuint vertStride,
+    VOXenum indexType,
+    VOXuint vertexCount,
+    VOXuint triangleCount);
+
+void voxUpdateMesh(
+    VOXhandle mesh,
+    VOXenum sourceFlags,
+    void* sourceData);
+
 VOXhandle voxCreateVolume(
     VOXhandle context,
     VOXuint width,
@@ -95,6 +147,36 @@ void voxUpdateVolume(
     VOXenum sourceFlags,
     void* sourceData);
 
+// Copies the voxels into tightly-packed, linearly-addressed CPU memory.
+void voxReadVolume(
+    VOXhandle volume,
+    void* destData);
+
+// Returns the number of non-zero voxels.
+VOXuint64 voxCountVoxels(VOXhandle volume);
+
+// Returns VOX_TRUE if the voxel is non-zero.
+VOXbool voxLookupVoxel(VOXhandle volume, VOXuint x, VOXuint y, VOXuint z);
+
+// Calls back once for every non-zero voxel, in no particular order for hash volumes and in
+// Morton order for octree volumes.
+void voxIterateVoxels(
+    VOXhandle volume,
+    void (*callback)(VOXuint x, VOXuint y, VOXuint z, void* userData),
+    void* userData);
+
+// Casts a ray in voxel coordinates, where voxel (x, y, z) spans [x, x+1) and so on, and finds
+// the first non-zero voxel within maxDistance along it.  distance receives the ray parameter
+// at which the ray enters that voxel, and may be null.  Octree volumes skip empty space a
+// whole node at a time.
+VOXbool voxCastRay(
+    VOXhandle volume,
+    const VOXfloat origin[3],
+    const VOXfloat direction[3],
+    VOXfloat maxDistance,
+    VOXuint hit[3],
+    VOXfloat* distance);
+
 VOXhandle voxCreateImage(
     VOXhandle context,
     VOXuint width,
@@ -125,7 +207,7 @@ void voxSweepVolume(VOXhandle destVolume, VOXhandle srcVolume, VOXhandle path, V
 void voxGenerate(VOXhandle destVolume, VOXenum generateOp);
 void voxTransform(VOXhandle destVolume, VOXhandle srcVolume, VOXenum transformOp);
 void voxBlend(VOXhandle destVolume, VOXhandle volume0, VOXhandle volume1, VOXenum blendOp);
-void voxCopy(VOXhandle destVolume, VOXhandle srcVolume);
+void voxCopy(VOXhandle destVolume, VOXhandle srcVolume); // also converts between VOX_TYPE_BIT and VOX_TYPE_UINT8
 
 void voxGetParamv(VOXenum param, void*);
 void voxResetParamv(VOXenum param);
@@ -141,3 +223,7 @@ void voxSetParam2f(VOXenum param, VOXfloat, VOXfloat);
 void voxSetParam3f(VOXenum param, VOXfloat, VOXfloat, VOXfloat);
 void voxSetParam4f(VOXenum param, VOXfloat, VOXfloat, VOXfloat, VOXfloat);
 void voxSetParamfv(VOXenum param, VOXfloat*);
+
+#ifdef __cplusplus
+}
+#endif